@@ -0,0 +1,51 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef BENCH_BUS_H
+#define BENCH_BUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "mmc5983ma.h"
+
+/**
+ * Counting mock transport: a register file in RAM, every transaction is
+ * counted and timed as an I2C transfer at BENCH_BUS_HZ.
+ */
+
+#define BENCH_BUS_HZ 400000U
+
+typedef struct {
+  uint64_t transactions;
+  uint64_t bytes;
+  uint64_t bits; // SCL periods, start/stop/ack included
+  uint64_t delay_ms;
+} bench_bus_stats_t;
+
+extern bench_bus_stats_t bench_bus_stats;
+
+int32_t bench_bus_write(void *handle, uint8_t reg, const uint8_t *data,
+                        uint16_t len);
+int32_t bench_bus_read(void *handle, uint8_t reg, uint8_t *data,
+                       uint16_t len);
+void bench_bus_mdelay(uint32_t millisec);
+
+void bench_bus_clear(void);
+
+// C++ binding entry points, see bench_cpp.cpp
+int32_t bench_cpp_status(mmc5983ma_status_t *val);
+int32_t bench_cpp_sample(mmc5983ma_magneto_data_t *val);
+int32_t bench_cpp_configure(void);
+int32_t bench_cpp_configure_all(void);
+int32_t bench_cpp_getters(mmc5983ma_bw_t *bw,
+                          mmc5983ma_continuous_mode_freq_t *freq,
+                          uint8_t *val);
+int32_t bench_cpp_reset(void);
+const mmc5983ma_shadow_t *bench_cpp_shadow(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,93 @@
+#include "bench_bus.h"
+#include "mmc5983ma.hpp"
+
+namespace {
+
+// Same counting transport as the C path, called directly instead of through
+// memsicdev_ctx_t
+struct bench_policy {
+  int32_t write(uint8_t reg, const uint8_t *data, uint16_t len) {
+    return bench_bus_write(nullptr, reg, data, len);
+  }
+  int32_t read(uint8_t reg, uint8_t *data, uint16_t len) {
+    return bench_bus_read(nullptr, reg, data, len);
+  }
+  void mdelay(uint32_t millisec) { bench_bus_mdelay(millisec); }
+};
+
+mmc5983ma::device<bench_policy> dev;
+
+} // namespace
+
+int32_t bench_cpp_status(mmc5983ma_status_t *val) {
+  return dev.status_get(val);
+}
+
+int32_t bench_cpp_sample(mmc5983ma_magneto_data_t *val) {
+  mmc5983ma_raw_magneto_data_t raw;
+  int32_t ret;
+
+  ret = dev.take_magnetic_field_measurement();
+  if (ret != 0)
+    return ret;
+  ret = dev.raw_magnetic_field_measurement_get(raw);
+  if (ret != 0)
+    return ret;
+
+  return dev.magnetic_field_measurement_get(raw, *val);
+}
+
+int32_t bench_cpp_configure(void) {
+  int32_t ret;
+
+  ret = dev.bandwith_set(MMC5983MA_BW_200HZ);
+  ret |= dev.cm_freq_set(MMC5983MA_CONTINIOUS_MODE_FREQ_100HZ);
+  ret |= dev.cmm_en_set(1);
+  ret |= dev.auto_sr_set(1);
+
+  return ret;
+}
+
+// Same sequence as op_configure_all
+int32_t bench_cpp_configure_all(void) {
+  int32_t ret;
+
+  ret = dev.meas_done_int_set(1);
+  ret |= dev.set_operation();
+  ret |= dev.reset_operation();
+  ret |= dev.x_inhibit_set(1);
+  ret |= dev.yz_inhibit_set(3);
+  ret |= dev.prd_set_set(1);
+  ret |= dev.en_prd_set_set(1);
+  ret |= dev.set_enp_set(1);
+  ret |= dev.set_enm_set(0);
+  ret |= dev.spi_3w_set(1);
+
+  return ret;
+}
+
+// Same order as op_getters
+int32_t bench_cpp_getters(mmc5983ma_bw_t *bw,
+                          mmc5983ma_continuous_mode_freq_t *freq,
+                          uint8_t *val) {
+  int32_t ret;
+
+  ret = dev.bandwith_get(bw);
+  ret |= dev.cm_freq_get(freq);
+  ret |= dev.meas_done_int_get(&val[0]);
+  ret |= dev.auto_sr_get(&val[1]);
+  ret |= dev.x_inhibit_get(&val[2]);
+  ret |= dev.yz_inhibit_get(&val[3]);
+  ret |= dev.cmm_en_get(&val[4]);
+  ret |= dev.prd_set_get(&val[5]);
+  ret |= dev.en_prd_set_get(&val[6]);
+  ret |= dev.set_enp_get(&val[7]);
+  ret |= dev.set_enm_get(&val[8]);
+  ret |= dev.spi_3w_get(&val[9]);
+
+  return ret;
+}
+
+int32_t bench_cpp_reset(void) { return dev.reset(); }
+
+const mmc5983ma_shadow_t *bench_cpp_shadow(void) { return &dev.shadow(); }
@@ -0,0 +1,1142 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_bus.h"
+#include "mmc5983ma_allan.h"
+#include "mmc5983ma_codec.h"
+#include "mmc5983ma_ring.h"
+#include "mmc5983ma_ts.h"
+#include <math.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ptrace.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <gnu/libc-version.h>
+#endif
+
+/**
+ * Host benchmark of the driver.
+ *
+ * Every operation runs against the counting mock transport and reports bus
+ * transactions, bytes, simulated bus time, instructions and host ns per
+ * operation. The figures are checked against a budget file, one line per
+ * operation:
+ *
+ *   <operation> <transactions> <bytes> <bus_us> <instructions> <ns_per_op>
+ *
+ * where '-' leaves a metric unchecked. Instructions are counted exactly by
+ * single stepping a forked copy of the bench with ptrace, so they do not
+ * depend on host load. They do depend on the compiler, its default flags and
+ * the C library: the budget file records the toolchain they were measured
+ * with on a line
+ *
+ *   toolchain <compiler banner, flags, C library>
+ *
+ * and instruction budgets are only enforced when this build matches it and
+ * ptrace is available; otherwise they are reported. Bus figures and ns
+ * ceilings are always enforced. Usage:
+ *
+ *   bench_mmc5983ma <budgets> [report.json [stream.txt...]]
+ *
+ * Each stream file (one sample per line: xraw_1 yraw_1 zraw_1, '#' starts a
+ * comment) is packed with the codec in blocks of BENCH_BLOCK samples; its
+ * compression ratio and encode / decode ns per sample are reported, and the
+ * run fails if a stream does not decode back to itself.
+ *
+ * Operations with a check function have their last result verified after the
+ * timed loop, so a wrong result fails the run without being timed.
+ *
+ * Exits with 1 when a budget is exceeded, when an operation has no budget or
+ * when a budget names an unknown operation, and with 2 when an operation
+ * fails or returns a wrong result.
+ */
+
+#define BENCH_BLOCK 64U
+#define BENCH_MAX_READERS 16U
+#define BENCH_MAX_OPS 32U
+#define BENCH_MAX_STREAMS 8U
+#define BENCH_STREAM_MAX 65536U
+#define BENCH_STEP_ITERATIONS 8U // calls single stepped per operation
+#define BENCH_TOOLCHAIN_MAX 512U
+
+// Compiler banner and flags, from the Makefile
+#ifndef BENCH_TOOLCHAIN
+#define BENCH_TOOLCHAIN "unknown"
+#endif
+
+typedef int32_t (*bench_op_fn)(void);
+
+typedef struct {
+  const char *name;
+  bench_op_fn fn;
+  uint32_t iterations;
+  bench_op_fn check; // NULL -> result not checked
+} bench_op_t;
+
+#define BENCH_TRANSACTIONS 0U
+#define BENCH_BYTES 1U
+#define BENCH_BUS_US 2U
+#define BENCH_INSTRUCTIONS 3U // negative -> ptrace not available
+#define BENCH_NS_PER_OP 4U
+#define BENCH_METRICS 5U
+
+typedef struct {
+  double metric[BENCH_METRICS];
+} bench_metrics_t;
+
+typedef struct {
+  const char *name;
+  uint32_t samples;
+  size_t packed;
+  double encode_ns; // per sample
+  double decode_ns; // per sample
+  uint8_t lossless;
+} bench_stream_t;
+
+typedef struct {
+  char name[32];
+  double limit[BENCH_METRICS]; // negative -> unchecked
+  uint8_t used;
+} bench_budget_t;
+
+/* Mock transport ------------------------------------------------------------*/
+
+bench_bus_stats_t bench_bus_stats;
+
+static uint8_t bench_regs[MMC5983MA_WHO_AM_I + 1] = {
+    0x80, 0x12, 0x7f, 0xa0, 0x81, 0x05, 0xe4, 0x55, 0x01,
+    [MMC5983MA_WHO_AM_I] = MMC5983MA_ID};
+
+int32_t bench_bus_write(void *handle, uint8_t reg, const uint8_t *data,
+                        uint16_t len) {
+  uint16_t i;
+
+  (void)handle;
+  if ((uint32_t)reg + len > sizeof(bench_regs))
+    return -1;
+
+  // Control registers are write only, keep the data registers stable
+  for (i = 0; i < len; i++)
+    if (reg + i >= MMC5983MA_INTERNAL_CTRL_0)
+      bench_regs[reg + i] = data[i];
+
+  // start, address, register, data, each byte acked, stop
+  bench_bus_stats.transactions++;
+  bench_bus_stats.bytes += len;
+  bench_bus_stats.bits += 2U + 9U * (2U + (uint64_t)len);
+
+  return 0;
+}
+
+int32_t bench_bus_read(void *handle, uint8_t reg, uint8_t *data,
+                       uint16_t len) {
+  (void)handle;
+  if ((uint32_t)reg + len > sizeof(bench_regs))
+    return -1;
+
+  memcpy(data, &bench_regs[reg], len);
+
+  // start, address, register, repeated start, address, data, stop
+  bench_bus_stats.transactions++;
+  bench_bus_stats.bytes += len;
+  bench_bus_stats.bits += 3U + 9U * (3U + (uint64_t)len);
+
+  return 0;
+}
+
+void bench_bus_mdelay(uint32_t millisec) {
+  bench_bus_stats.delay_ms += millisec;
+}
+
+void bench_bus_clear(void) {
+  memset(&bench_bus_stats, 0, sizeof(bench_bus_stats));
+}
+
+/* Operations ----------------------------------------------------------------*/
+
+static mmc5983ma_shadow_t bench_shadow;
+static memsicdev_ctx_t bench_ctx = {bench_bus_write, bench_bus_read,
+                                    bench_bus_mdelay, NULL, NULL, NULL};
+
+static mmc5983ma_raw_magneto_data_t bench_raw[BENCH_BLOCK];
+static mmc5983ma_raw_magneto_data_t bench_decoded[BENCH_BLOCK];
+static mmc5983ma_magneto_data_t bench_val[BENCH_BLOCK];
+static uint8_t bench_packed[MMC5983MA_CODEC_BLOCK_BOUND(BENCH_BLOCK)];
+static size_t bench_packed_len;
+static int64_t bench_stamps[BENCH_BLOCK];
+static mmc5983ma_ring_t *bench_ring;
+static mmc5983ma_ring_reader_t bench_reader;
+typedef struct {
+  mmc5983ma_ring_t *ring;
+  mmc5983ma_ring_reader_t reader[BENCH_MAX_READERS];
+  uint32_t readers;
+  uint64_t index;
+} bench_fanout_t;
+
+// One ring per reader count, so idle readers are never lapped
+static bench_fanout_t bench_fanout_set[3] = {
+    {NULL, {{0, 0}}, 1, 0}, {NULL, {{0, 0}}, 4, 0}, {NULL, {{0, 0}}, 16, 0}};
+static mmc5983ma_ts_t bench_ts;
+static uint64_t bench_ts_index;
+static uint32_t bench_ts_seed = 1U;
+static mmc5983ma_allan_t bench_allan;
+static uint32_t bench_allan_index;
+
+// Host clock of ts_observe: sensor oscillator off by BENCH_TS_SKEW_PPM,
+// host reads jittered by up to +/- BENCH_TS_JITTER_NS
+#define BENCH_TS_SKEW_PPM 50.0
+#define BENCH_TS_JITTER_NS 10000.0
+#define BENCH_TS_PERIOD_NS (1e7 / (1.0 + BENCH_TS_SKEW_PPM * 1e-6))
+
+// Last results, verified by the check functions
+static uint8_t bench_id;
+static mmc5983ma_status_t bench_status;
+static struct {
+  mmc5983ma_bw_t bw;
+  mmc5983ma_continuous_mode_freq_t freq;
+  uint8_t val[10];
+} bench_got;
+
+static int32_t op_device_id(void) {
+  return mmc5983ma_device_id_get(&bench_ctx, &bench_id);
+}
+
+static int32_t check_device_id(void) {
+  return (bench_id == MMC5983MA_ID) ? 0 : -1;
+}
+
+static int32_t op_status(void) {
+  return mmc5983ma_status_get(&bench_ctx, &bench_status);
+}
+
+static int32_t op_status_cpp(void) { return bench_cpp_status(&bench_status); }
+
+static int32_t check_status(void) {
+  // Mock status register is 0x01: measurement done, nothing else
+  return ((bench_status.Meas_M_Done == 1U) &&
+          (bench_status.Meas_T_Done == 0U) && (bench_status.OTP_Rd_Done == 0U))
+             ? 0
+             : -1;
+}
+
+static int32_t op_sample(void) {
+  mmc5983ma_raw_magneto_data_t raw;
+  int32_t ret;
+
+  ret = mmc5983ma_take_magnetic_field_measurement_set(&bench_ctx, 1);
+  if (ret != 0)
+    return ret;
+  ret = mmc5983ma_raw_magnetic_field_measurement_get(&bench_ctx, &raw);
+  if (ret != 0)
+    return ret;
+
+  return mmc5983ma_magnetic_field_measurement_get(&bench_ctx, &raw,
+                                                  &bench_val[0]);
+}
+
+/**
+ * @brief  Field computed from the mock output registers, bit by bit
+ *
+ */
+static int32_t check_sample(void) {
+  const uint8_t *r = bench_regs;
+  mmc5983ma_raw_magneto_data_t raw;
+  mmc5983ma_magneto_data_t val;
+
+  raw.xraw_1 = ((uint32_t)r[0] << 10) | ((uint32_t)r[1] << 2) | (r[6] >> 6);
+  raw.yraw_1 =
+      ((uint32_t)r[2] << 10) | ((uint32_t)r[3] << 2) | ((r[6] >> 4) & 3U);
+  raw.zraw_1 =
+      ((uint32_t)r[4] << 10) | ((uint32_t)r[5] << 2) | ((r[6] >> 2) & 3U);
+  mmc5983ma_magnetic_field_measurement_get(&bench_ctx, &raw, &val);
+
+  return ((bench_val[0].x == val.x) && (bench_val[0].y == val.y) &&
+          (bench_val[0].z == val.z))
+             ? 0
+             : -1;
+}
+
+static int32_t op_sample_cpp(void) { return bench_cpp_sample(&bench_val[0]); }
+
+static int32_t op_temperature(void) {
+  return mmc5983ma_take_temperature_measurement_set(&bench_ctx, 1);
+}
+
+static int32_t op_configure(void) {
+  int32_t ret;
+
+  ret = mmc5983ma_bandwith_set(&bench_ctx, MMC5983MA_BW_200HZ);
+  ret |= mmc5983ma_cm_freq_set(&bench_ctx,
+                               MMC5983MA_CONTINIOUS_MODE_FREQ_100HZ);
+  ret |= mmc5983ma_cmm_en_set(&bench_ctx, 1);
+  ret |= mmc5983ma_auto_sr_set(&bench_ctx, 1);
+
+  return ret;
+}
+
+static int32_t op_configure_cpp(void) { return bench_cpp_configure(); }
+
+// Same settings through both bindings give the same registers
+static int32_t check_configure_cpp(void) {
+  const mmc5983ma_shadow_t *cpp = bench_cpp_shadow();
+
+  return ((cpp->internal_control0 == bench_shadow.internal_control0) &&
+          (cpp->internal_control1 == bench_shadow.internal_control1) &&
+          (cpp->internal_control2 == bench_shadow.internal_control2) &&
+          (cpp->internal_control3 == bench_shadow.internal_control3))
+             ? 0
+             : -1;
+}
+
+static int32_t op_configure_all(void) {
+  int32_t ret;
+
+  ret = mmc5983ma_meas_done_int_set(&bench_ctx, 1);
+  ret |= mmc5983ma_set_operation_set(&bench_ctx, 1);
+  ret |= mmc5983ma_reset_operation_set(&bench_ctx, 1);
+  ret |= mmc5983ma_x_inhibit_set(&bench_ctx, 1);
+  ret |= mmc5983ma_yz_inhibit_set(&bench_ctx, 3);
+  ret |= mmc5983ma_prd_set_set(&bench_ctx, 1);
+  ret |= mmc5983ma_en_prd_set_set(&bench_ctx, 1);
+  ret |= mmc5983ma_set_enp_set(&bench_ctx, 1);
+  ret |= mmc5983ma_set_enm_set(&bench_ctx, 0);
+  ret |= mmc5983ma_spi_3w_set(&bench_ctx, 1);
+
+  return ret;
+}
+
+static int32_t op_configure_all_cpp(void) { return bench_cpp_configure_all(); }
+
+/**
+ * @brief  Register bytes on the bus, from the datasheet bit positions
+ *
+ */
+static int32_t check_configure_all(void) {
+  // CTRL1: BW 200 Hz, X_inhibit bit 2, YZ_inhibit bits 3-4
+  // CTRL2: Cm_freq 100 Hz, Cmm_en bit 3, Prd_set 1 in bits 4-6, En_prd_set
+  // CTRL3: St_enp bit 1, Spi_3w bit 6; no CTRL3 field matches CTRL2
+  return ((bench_regs[MMC5983MA_INTERNAL_CTRL_1] == 0x1DU) &&
+          (bench_regs[MMC5983MA_INTERNAL_CTRL_2] == 0x9DU) &&
+          (bench_regs[MMC5983MA_INTERNAL_CTRL_3] == 0x42U) &&
+          (bench_shadow.internal_control0 == 0x24U))
+             ? 0
+             : -1;
+}
+
+// Same bytes on the bus as the C path, and the same shadow
+static int32_t check_configure_all_cpp(void) {
+  if (check_configure_all() != 0)
+    return -1;
+
+  return check_configure_cpp();
+}
+
+static int32_t op_getters(void) {
+  uint8_t *val = bench_got.val;
+  int32_t ret;
+
+  ret = mmc5983ma_bandwith_get(&bench_ctx, &bench_got.bw);
+  ret |= mmc5983ma_cm_freq_get(&bench_ctx, &bench_got.freq);
+  ret |= mmc5983ma_meas_done_int_get(&bench_ctx, &val[0]);
+  ret |= mmc5983ma_auto_sr_get(&bench_ctx, &val[1]);
+  ret |= mmc5983ma_x_inhibit_get(&bench_ctx, &val[2]);
+  ret |= mmc5983ma_yz_inhibit_get(&bench_ctx, &val[3]);
+  ret |= mmc5983ma_cmm_en_get(&bench_ctx, &val[4]);
+  ret |= mmc5983ma_prd_set_get(&bench_ctx, &val[5]);
+  ret |= mmc5983ma_en_prd_set_get(&bench_ctx, &val[6]);
+  ret |= mmc5983ma_set_enp_get(&bench_ctx, &val[7]);
+  ret |= mmc5983ma_set_enm_get(&bench_ctx, &val[8]);
+  ret |= mmc5983ma_spi_3w_get(&bench_ctx, &val[9]);
+
+  return ret;
+}
+
+static int32_t op_getters_cpp(void) {
+  return bench_cpp_getters(&bench_got.bw, &bench_got.freq, bench_got.val);
+}
+
+// Values left by the configure and configure_all operations
+static int32_t check_getters(void) {
+  static const uint8_t expected[10] = {1, 1, 1, 3, 1, 1, 1, 1, 0, 1};
+  int32_t ret;
+
+  ret = ((bench_got.bw == MMC5983MA_BW_200HZ) &&
+         (bench_got.freq == MMC5983MA_CONTINIOUS_MODE_FREQ_100HZ) &&
+         (memcmp(bench_got.val, expected, sizeof(expected)) == 0))
+            ? 0
+            : -1;
+
+  // The next getters operation must write every value again
+  memset(&bench_got, 0xFF, sizeof(bench_got));
+
+  return ret;
+}
+
+static int32_t op_reset(void) { return mmc5983ma_reset(&bench_ctx); }
+
+static int32_t op_reset_cpp(void) { return bench_cpp_reset(); }
+
+static int32_t op_conversion(void) {
+  return mmc5983ma_magnetic_field_measurement_get(&bench_ctx, &bench_raw[0],
+                                                  &bench_val[0]);
+}
+
+// 0.0625 mG per count from -8 G: 0 -> -8 G, 128000 -> 0 G, 256000 -> 8 G
+static int32_t check_conversion(void) {
+  mmc5983ma_raw_magneto_data_t raw = {.xraw_1 = 0U,
+                                      .yraw_1 = 128000U,
+                                      .zraw_1 = 256000U};
+  mmc5983ma_magneto_data_t val;
+
+  mmc5983ma_magnetic_field_measurement_get(&bench_ctx, &raw, &val);
+
+  return ((fabsf(val.x + 8.f) < 1e-6f) && (fabsf(val.y) < 1e-6f) &&
+          (fabsf(val.z - 8.f) < 1e-6f))
+             ? 0
+             : -1;
+}
+
+static int32_t op_batch_conversion(void) {
+  return mmc5983ma_magnetic_field_measurement_batch_get(bench_raw, bench_val,
+                                                        BENCH_BLOCK);
+}
+
+// The batch path must agree with the one sample conversion
+static int32_t check_batch_conversion(void) {
+  mmc5983ma_magneto_data_t val;
+  uint32_t i;
+
+  for (i = 0; i < BENCH_BLOCK; i++) {
+    mmc5983ma_magnetic_field_measurement_get(&bench_ctx, &bench_raw[i], &val);
+    if ((val.x != bench_val[i].x) || (val.y != bench_val[i].y) ||
+        (val.z != bench_val[i].z))
+      return -1;
+  }
+
+  return 0;
+}
+
+static int32_t op_ring(void) {
+  mmc5983ma_ring_sample_t sample;
+  int32_t ret;
+
+  ret = mmc5983ma_ring_push(bench_ring, 0, 0, &bench_raw[0]);
+  if (ret != 0)
+    return ret;
+
+  ret = mmc5983ma_ring_read(bench_ring, &bench_reader, &sample);
+  if (ret != 0)
+    return -1;
+
+  return ((sample.x == bench_raw[0].xraw_1) &&
+          (sample.y == bench_raw[0].yraw_1) &&
+          (sample.z == bench_raw[0].zraw_1))
+             ? 0
+             : -1;
+}
+
+/**
+ * @brief  One acquisition (a single bus read) consumed by every reader
+ *
+ */
+static int32_t bench_fanout(bench_fanout_t *fanout) {
+  mmc5983ma_raw_magneto_data_t raw;
+  mmc5983ma_ring_sample_t sample;
+  uint32_t i;
+  int32_t ret;
+
+  ret = mmc5983ma_raw_magnetic_field_measurement_get(&bench_ctx, &raw);
+  if (ret != 0)
+    return ret;
+  ret = mmc5983ma_ring_push(fanout->ring, 0, fanout->index, &raw);
+  if (ret != 0)
+    return ret;
+
+  // Every reader must see exactly this sample, without touching the bus
+  for (i = 0; i < fanout->readers; i++) {
+    if ((mmc5983ma_ring_read(fanout->ring, &fanout->reader[i], &sample) !=
+         0) ||
+        (sample.index != fanout->index) || (sample.x != raw.xraw_1) ||
+        (sample.y != raw.yraw_1) || (sample.z != raw.zraw_1))
+      return -1;
+  }
+  fanout->index++;
+
+  return 0;
+}
+
+static int32_t op_fanout_1(void) { return bench_fanout(&bench_fanout_set[0]); }
+
+static int32_t op_fanout_4(void) { return bench_fanout(&bench_fanout_set[1]); }
+
+static int32_t op_fanout_16(void) {
+  return bench_fanout(&bench_fanout_set[2]);
+}
+
+static int32_t op_codec_encode(void) {
+  return mmc5983ma_codec_encode(bench_raw, BENCH_BLOCK, bench_packed,
+                                sizeof(bench_packed), &bench_packed_len);
+}
+
+static int32_t op_codec_decode(void) {
+  uint16_t count;
+
+  return mmc5983ma_codec_decode(bench_packed, bench_packed_len, bench_decoded,
+                                BENCH_BLOCK, &count);
+}
+
+static int32_t check_codec_decode(void) {
+  uint32_t i;
+
+  for (i = 0; i < BENCH_BLOCK; i++)
+    if ((bench_decoded[i].xraw_1 != bench_raw[i].xraw_1) ||
+        (bench_decoded[i].yraw_1 != bench_raw[i].yraw_1) ||
+        (bench_decoded[i].zraw_1 != bench_raw[i].zraw_1))
+      return -1;
+
+  return 0;
+}
+
+static int32_t op_ts_observe(void) {
+  double noise;
+
+  bench_ts_index += 100U;
+  bench_ts_seed = bench_ts_seed * 1103515245U + 12345U;
+  noise = ((double)(bench_ts_seed >> 8) / 8388608.0 - 1.0) * BENCH_TS_JITTER_NS;
+
+  return mmc5983ma_ts_observe(
+      &bench_ts, bench_ts_index,
+      (int64_t)(BENCH_TS_PERIOD_NS * (double)bench_ts_index + noise));
+}
+
+// Skew recovered to 1 ppm, jitter close to the RMS of the uniform noise
+static int32_t check_ts_observe(void) {
+  float drift;
+  float jitter;
+
+  if ((mmc5983ma_ts_drift_ppm_get(&bench_ts, &drift) != 0) ||
+      (mmc5983ma_ts_jitter_get(&bench_ts, &jitter) != 0))
+    return -1;
+
+  return ((fabs(drift - BENCH_TS_SKEW_PPM) < 1.0) &&
+          (fabs(jitter - BENCH_TS_JITTER_NS / sqrt(3.0)) <
+           0.2 * BENCH_TS_JITTER_NS))
+             ? 0
+             : -1;
+}
+
+static int32_t op_ts_stamp(void) {
+  return mmc5983ma_ts_stamp(&bench_ts, bench_ts_index, BENCH_BLOCK,
+                            bench_stamps);
+}
+
+static int32_t check_ts_stamp(void) {
+  uint32_t i;
+
+  for (i = 0; i < BENCH_BLOCK; i++)
+    if (fabs((double)bench_stamps[i] -
+             BENCH_TS_PERIOD_NS * (double)(bench_ts_index + i)) > 5000.0)
+      return -1;
+
+  return 0;
+}
+
+static int32_t op_allan(void) {
+  bench_allan_index = (bench_allan_index + 1U) % BENCH_BLOCK;
+
+  return mmc5983ma_allan_push(&bench_allan, &bench_raw[bench_allan_index]);
+}
+
+// The block repeats every BENCH_BLOCK samples: noise at short tau only
+static int32_t check_allan(void) {
+  mmc5983ma_magneto_data_t val;
+  float tau;
+
+  if (mmc5983ma_allan_deviation_get(&bench_allan, 0, &tau, &val) != 0)
+    return -1;
+
+  return ((fabsf(tau - 0.01f) < 1e-6f) && (val.x > 0.f) && (val.x < 1e-2f) &&
+          (val.y > 0.f) && (val.y < 1e-2f) && (val.z > 0.f) &&
+          (val.z < 1e-2f))
+             ? 0
+             : -1;
+}
+
+static const bench_op_t bench_ops[] = {
+    {"device_id", op_device_id, 100000, check_device_id},
+    {"status", op_status, 100000, check_status},
+    {"status_cpp", op_status_cpp, 100000, check_status},
+    {"sample", op_sample, 100000, check_sample},
+    {"sample_cpp", op_sample_cpp, 100000, check_sample},
+    {"temperature", op_temperature, 100000, NULL},
+    {"configure", op_configure, 100000, NULL},
+    {"configure_cpp", op_configure_cpp, 100000, check_configure_cpp},
+    {"configure_all", op_configure_all, 100000, check_configure_all},
+    {"configure_all_cpp", op_configure_all_cpp, 100000,
+     check_configure_all_cpp},
+    {"getters", op_getters, 100000, check_getters},
+    {"getters_cpp", op_getters_cpp, 100000, check_getters},
+    {"reset", op_reset, 100000, NULL},
+    {"reset_cpp", op_reset_cpp, 100000, NULL},
+    {"conversion", op_conversion, 1000000, check_conversion},
+    {"batch_conversion_64", op_batch_conversion, 100000,
+     check_batch_conversion},
+    {"ring_push_read", op_ring, 1000000, NULL},
+    {"fanout_1", op_fanout_1, 100000, NULL},
+    {"fanout_4", op_fanout_4, 100000, NULL},
+    {"fanout_16", op_fanout_16, 100000, NULL},
+    {"codec_encode_64", op_codec_encode, 100000, NULL},
+    {"codec_decode_64", op_codec_decode, 100000, check_codec_decode},
+    {"ts_observe", op_ts_observe, 1000000, check_ts_observe},
+    {"ts_stamp_64", op_ts_stamp, 100000, check_ts_stamp},
+    {"allan_push", op_allan, 1000000, check_allan},
+};
+
+#define BENCH_OPS (sizeof(bench_ops) / sizeof(bench_ops[0]))
+
+/* Harness -------------------------------------------------------------------*/
+
+static const char *const bench_metric_names[BENCH_METRICS] = {
+    "transactions", "bytes", "bus_us", "instructions", "ns_per_op"};
+
+static int64_t bench_now_ns(void) {
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int32_t bench_setup(void) {
+  uint32_t x = 131072U;
+  uint32_t y = 120000U;
+  uint32_t z = 140000U;
+  uint32_t seed = 1U;
+  uint32_t i;
+  uint32_t k;
+  size_t size;
+
+  // Random walk with a few LSB of noise, close to a sensor at rest
+  for (i = 0; i < BENCH_BLOCK; i++) {
+    seed = seed * 1103515245U + 12345U;
+    x = (x + ((seed >> 16) % 33U) - 16U) & 0x3FFFFU;
+    y = (y + ((seed >> 8) % 17U) - 8U) & 0x3FFFFU;
+    z = (z + ((seed >> 4) % 65U) - 32U) & 0x3FFFFU;
+    bench_raw[i].xraw_1 = x;
+    bench_raw[i].yraw_1 = y;
+    bench_raw[i].zraw_1 = z;
+  }
+
+  if (mmc5983ma_shadow_bind(&bench_ctx, &bench_shadow) != 0)
+    return -1;
+
+  size = mmc5983ma_ring_size(1024);
+  bench_ring = (mmc5983ma_ring_t *)malloc(size);
+  if ((bench_ring == NULL) || (mmc5983ma_ring_init(bench_ring, 1024) != 0) ||
+      (mmc5983ma_ring_reader_init(bench_ring, &bench_reader) != 0))
+    return -1;
+
+  for (k = 0; k < 3U; k++) {
+    bench_fanout_set[k].ring = (mmc5983ma_ring_t *)malloc(size);
+    if ((bench_fanout_set[k].ring == NULL) ||
+        (mmc5983ma_ring_init(bench_fanout_set[k].ring, 1024) != 0))
+      return -1;
+    for (i = 0; i < bench_fanout_set[k].readers; i++)
+      if (mmc5983ma_ring_reader_init(bench_fanout_set[k].ring,
+                                     &bench_fanout_set[k].reader[i]) != 0)
+        return -1;
+  }
+
+  if ((mmc5983ma_ts_init(&bench_ts, 100.f, 64) != 0) ||
+      (mmc5983ma_allan_init(&bench_allan, 0.01f) != 0))
+    return -1;
+
+  return op_codec_encode();
+}
+
+static int32_t bench_run(const bench_op_t *op, bench_metrics_t *val) {
+  int64_t start;
+  uint32_t i;
+  double n = (double)op->iterations;
+
+  // Warm up, then measure
+  for (i = 0; i < op->iterations / 10U; i++)
+    if (op->fn() < 0)
+      return -1;
+
+  bench_bus_clear();
+  start = bench_now_ns();
+  for (i = 0; i < op->iterations; i++)
+    if (op->fn() < 0)
+      return -1;
+  val->metric[BENCH_NS_PER_OP] = (double)(bench_now_ns() - start) / n;
+
+  val->metric[BENCH_TRANSACTIONS] = (double)bench_bus_stats.transactions / n;
+  val->metric[BENCH_BYTES] = (double)bench_bus_stats.bytes / n;
+  val->metric[BENCH_BUS_US] = ((double)bench_bus_stats.bits * 1e6 / BENCH_BUS_HZ +
+                 (double)bench_bus_stats.delay_ms * 1e3) /
+                n;
+
+  return (op->check != NULL) ? op->check() : 0;
+}
+
+/**
+ * @brief  Instructions retired by a forked copy running the operation
+ *         calls times, counted one ptrace single step at a time
+ *
+ */
+static int64_t bench_steps(const bench_op_t *op, uint32_t calls) {
+  int64_t steps = 0;
+  uint32_t i;
+  pid_t pid;
+  int status;
+
+  pid = fork();
+  if (pid < 0)
+    return -1;
+
+  if (pid == 0) {
+    if (ptrace(PTRACE_TRACEME, 0, NULL, NULL) != 0)
+      _exit(1);
+    raise(SIGSTOP);
+    for (i = 0; i < calls; i++)
+      op->fn();
+    raise(SIGSTOP);
+    _exit(0);
+  }
+
+  if ((waitpid(pid, &status, 0) != pid) || !WIFSTOPPED(status) ||
+      (WSTOPSIG(status) != SIGSTOP))
+    goto fail;
+
+  // From the first stop to the second one, one trap per instruction
+  for (;;) {
+    if ((ptrace(PTRACE_SINGLESTEP, pid, NULL, NULL) != 0) ||
+        (waitpid(pid, &status, 0) != pid) || !WIFSTOPPED(status))
+      goto fail;
+    if (WSTOPSIG(status) == SIGSTOP)
+      break;
+    if (WSTOPSIG(status) != SIGTRAP)
+      goto fail;
+    steps++;
+  }
+
+  kill(pid, SIGKILL);
+  waitpid(pid, &status, 0);
+
+  return steps;
+
+fail:
+  kill(pid, SIGKILL);
+  waitpid(pid, &status, 0);
+
+  return -1;
+}
+
+static double bench_instructions(const bench_op_t *op) {
+  int64_t empty = bench_steps(op, 0);
+  int64_t full = bench_steps(op, BENCH_STEP_ITERATIONS);
+
+  if ((empty < 0) || (full < empty))
+    return -1.0;
+
+  return (double)(full - empty) / BENCH_STEP_ITERATIONS;
+}
+
+static void bench_toolchain_get(char *val, size_t size) {
+#ifdef __GLIBC__
+  snprintf(val, size, "%s, glibc %s", BENCH_TOOLCHAIN,
+           gnu_get_libc_version());
+#else
+  snprintf(val, size, "%s", BENCH_TOOLCHAIN);
+#endif
+}
+
+static int32_t bench_budgets_load(const char *path, bench_budget_t *budget,
+                                  uint32_t *count, char *toolchain) {
+  FILE *f;
+  char line[BENCH_TOOLCHAIN_MAX];
+  char field[BENCH_METRICS][32];
+  uint32_t i;
+  int n;
+
+  f = fopen(path, "r");
+  if (f == NULL)
+    return -1;
+
+  *count = 0;
+  toolchain[0] = '\0';
+  while (fgets(line, sizeof(line), f) != NULL) {
+    if ((line[0] == '#') || (line[0] == '\n'))
+      continue;
+    if (strncmp(line, "toolchain ", 10) == 0) {
+      line[strcspn(line, "\n")] = '\0';
+      strcpy(toolchain, &line[10]);
+      continue;
+    }
+    if (*count >= BENCH_MAX_OPS) {
+      fclose(f);
+      return -1;
+    }
+
+    n = sscanf(line, "%31s %31s %31s %31s %31s %31s", budget[*count].name,
+               field[0], field[1], field[2], field[3], field[4]);
+    if (n != 1 + (int)BENCH_METRICS) {
+      fclose(f);
+      return -1;
+    }
+    for (i = 0; i < BENCH_METRICS; i++)
+      budget[*count].limit[i] =
+          (strcmp(field[i], "-") == 0) ? -1.0 : strtod(field[i], NULL);
+    budget[*count].used = 0;
+    (*count)++;
+  }
+
+  fclose(f);
+
+  return 0;
+}
+
+static int32_t bench_stream_load(const char *path,
+                                 mmc5983ma_raw_magneto_data_t *raw,
+                                 uint32_t *count) {
+  FILE *f;
+  char line[128];
+  unsigned long x;
+  unsigned long y;
+  unsigned long z;
+
+  f = fopen(path, "r");
+  if (f == NULL)
+    return -1;
+
+  *count = 0;
+  while ((fgets(line, sizeof(line), f) != NULL) &&
+         (*count < BENCH_STREAM_MAX)) {
+    if ((line[0] == '#') || (line[0] == '\n'))
+      continue;
+    if (sscanf(line, "%lu %lu %lu", &x, &y, &z) != 3) {
+      fclose(f);
+      return -1;
+    }
+    raw[*count].xraw_1 = (uint32_t)x;
+    raw[*count].yraw_1 = (uint32_t)y;
+    raw[*count].zraw_1 = (uint32_t)z;
+    (*count)++;
+  }
+
+  fclose(f);
+
+  return (*count > 0) ? 0 : -1;
+}
+
+/**
+ * @brief  Pack a stream in blocks, time encode / decode, check round trip
+ *
+ */
+static int32_t bench_stream_run(const char *path, bench_stream_t *val) {
+  mmc5983ma_raw_magneto_data_t *raw;
+  mmc5983ma_raw_magneto_data_t *decoded;
+  uint8_t *packed;
+  size_t len[BENCH_STREAM_MAX / BENCH_BLOCK];
+  size_t offset;
+  uint32_t blocks;
+  uint32_t repeat;
+  uint32_t r;
+  uint32_t b;
+  uint32_t i;
+  uint16_t n;
+  int64_t start;
+  int32_t ret = -1;
+
+  raw = calloc(BENCH_STREAM_MAX, sizeof(*raw));
+  decoded = calloc(BENCH_STREAM_MAX, sizeof(*decoded));
+  packed = malloc((BENCH_STREAM_MAX / BENCH_BLOCK) *
+                  MMC5983MA_CODEC_BLOCK_BOUND(BENCH_BLOCK));
+  val->name = path;
+  if ((raw == NULL) || (decoded == NULL) || (packed == NULL) ||
+      (bench_stream_load(path, raw, &val->samples) != 0))
+    goto out;
+
+  // Whole blocks only, so every block has the size used on the radio link
+  blocks = val->samples / BENCH_BLOCK;
+  if (blocks == 0)
+    goto out;
+  val->samples = blocks * BENCH_BLOCK;
+  repeat = 1U + (1U << 20) / val->samples;
+
+  start = bench_now_ns();
+  for (r = 0; r < repeat; r++) {
+    for (b = 0, offset = 0; b < blocks; b++) {
+      if (mmc5983ma_codec_encode(&raw[b * BENCH_BLOCK], BENCH_BLOCK,
+                                 &packed[offset],
+                                 MMC5983MA_CODEC_BLOCK_BOUND(BENCH_BLOCK),
+                                 &len[b]) != 0)
+        goto out;
+      offset += len[b];
+    }
+  }
+  val->encode_ns =
+      (double)(bench_now_ns() - start) / ((double)repeat * val->samples);
+  val->packed = offset;
+
+  start = bench_now_ns();
+  for (r = 0; r < repeat; r++) {
+    for (b = 0, offset = 0; b < blocks; b++) {
+      if (mmc5983ma_codec_decode(&packed[offset], len[b],
+                                 &decoded[b * BENCH_BLOCK], BENCH_BLOCK,
+                                 &n) != 0)
+        goto out;
+      offset += len[b];
+    }
+  }
+  val->decode_ns =
+      (double)(bench_now_ns() - start) / ((double)repeat * val->samples);
+
+  val->lossless = 1;
+  for (i = 0; i < val->samples; i++)
+    if ((decoded[i].xraw_1 != (raw[i].xraw_1 & 0x3FFFFU)) ||
+        (decoded[i].yraw_1 != (raw[i].yraw_1 & 0x3FFFFU)) ||
+        (decoded[i].zraw_1 != (raw[i].zraw_1 & 0x3FFFFU)))
+      val->lossless = 0;
+  ret = 0;
+
+out:
+  free(raw);
+  free(decoded);
+  free(packed);
+
+  return ret;
+}
+
+static void bench_report_json(FILE *f, const bench_metrics_t *metrics,
+                              const bench_budget_t *const *budget,
+                              const uint8_t *pass, uint8_t all_pass,
+                              const char *toolchain, uint8_t enforced,
+                              const bench_stream_t *streams,
+                              uint32_t stream_count) {
+  const char *c;
+  uint32_t i;
+  uint32_t m;
+
+  fprintf(f, "{\n  \"bus_hz\": %u,\n  \"pass\": %s,\n  \"toolchain\": \"",
+          BENCH_BUS_HZ, all_pass ? "true" : "false");
+  for (c = toolchain; *c != '\0'; c++)
+    fprintf(f, ((*c == '"') || (*c == '\\')) ? "\\%c" : "%c", *c);
+  fprintf(f, "\",\n  \"instructions_enforced\": %s,\n  \"operations\": [\n",
+          enforced ? "true" : "false");
+
+  for (i = 0; i < BENCH_OPS; i++) {
+    fprintf(f, "    {\"name\": \"%s\"", bench_ops[i].name);
+    for (m = 0; m < BENCH_METRICS; m++) {
+      if (metrics[i].metric[m] < 0.0)
+        fprintf(f, ", \"%s\": null", bench_metric_names[m]);
+      else
+        fprintf(f, ", \"%s\": %.3f", bench_metric_names[m],
+                metrics[i].metric[m]);
+    }
+    if (strcmp(bench_ops[i].name, "codec_encode_64") == 0)
+      fprintf(f, ", \"compression_ratio\": %.3f",
+              (double)(BENCH_BLOCK * 3U * sizeof(uint32_t)) /
+                  (double)bench_packed_len);
+
+    fprintf(f, ", \"budget\": {");
+    for (m = 0; (budget[i] != NULL) && (m < BENCH_METRICS); m++) {
+      if (budget[i]->limit[m] < 0.0)
+        fprintf(f, "%s\"%s\": null", m ? ", " : "", bench_metric_names[m]);
+      else
+        fprintf(f, "%s\"%s\": %.3f", m ? ", " : "", bench_metric_names[m],
+                budget[i]->limit[m]);
+    }
+    fprintf(f, "}, \"pass\": %s}%s\n", pass[i] ? "true" : "false",
+            (i + 1U < BENCH_OPS) ? "," : "");
+  }
+
+  fprintf(f, "  ],\n  \"streams\": [\n");
+  for (i = 0; i < stream_count; i++)
+    fprintf(f,
+            "    {\"name\": \"%s\", \"samples\": %u, \"packed_bytes\": %zu, "
+            "\"compression_ratio\": %.3f, \"encode_ns_per_sample\": %.3f, "
+            "\"decode_ns_per_sample\": %.3f, \"lossless\": %s}%s\n",
+            streams[i].name, streams[i].samples, streams[i].packed,
+            (double)(streams[i].samples * 3U * sizeof(uint32_t)) /
+                (double)streams[i].packed,
+            streams[i].encode_ns, streams[i].decode_ns,
+            streams[i].lossless ? "true" : "false",
+            (i + 1U < stream_count) ? "," : "");
+
+  fprintf(f, "  ]\n}\n");
+}
+
+/**
+ * @brief  Bus cost of an acquisition must not depend on the reader count
+ *
+ */
+static uint8_t bench_fanout_check(const bench_metrics_t *metrics) {
+  const bench_metrics_t *ref = NULL;
+  uint8_t pass = 1;
+  uint32_t i;
+
+  for (i = 0; i < BENCH_OPS; i++) {
+    if (strncmp(bench_ops[i].name, "fanout_", 7) != 0)
+      continue;
+    if (ref == NULL) {
+      ref = &metrics[i];
+      continue;
+    }
+    if ((metrics[i].metric[BENCH_TRANSACTIONS] !=
+         ref->metric[BENCH_TRANSACTIONS]) ||
+        (metrics[i].metric[BENCH_BYTES] != ref->metric[BENCH_BYTES])) {
+      printf("%s: bus traffic depends on the number of readers\n",
+             bench_ops[i].name);
+      pass = 0;
+    }
+  }
+
+  return pass;
+}
+
+int main(int argc, char **argv) {
+  static bench_budget_t budgets[BENCH_MAX_OPS];
+  static char budget_toolchain[BENCH_TOOLCHAIN_MAX];
+  static char toolchain[BENCH_TOOLCHAIN_MAX];
+  bench_metrics_t metrics[BENCH_OPS];
+  const bench_budget_t *budget[BENCH_OPS];
+  bench_stream_t streams[BENCH_MAX_STREAMS];
+  uint32_t stream_count = 0;
+  uint8_t pass[BENCH_OPS];
+  uint8_t reported;
+  uint8_t all_pass = 1;
+  uint8_t enforced;
+  uint8_t skipped = 0;
+  uint32_t budget_count;
+  uint32_t i;
+  uint32_t j;
+  uint32_t m;
+  FILE *f;
+
+  if ((argc < 2) || (argc > 3 + (int)BENCH_MAX_STREAMS)) {
+    fprintf(stderr, "usage: %s <budgets> [report.json [stream.txt...]]\n",
+            argv[0]);
+    return 2;
+  }
+  if (bench_budgets_load(argv[1], budgets, &budget_count, budget_toolchain) !=
+      0) {
+    fprintf(stderr, "cannot load budgets from %s\n", argv[1]);
+    return 2;
+  }
+  if (bench_setup() != 0) {
+    fprintf(stderr, "setup failed\n");
+    return 2;
+  }
+
+  bench_toolchain_get(toolchain, sizeof(toolchain));
+  enforced = (strcmp(toolchain, budget_toolchain) == 0);
+  printf("toolchain: %s\n", toolchain);
+  if (!enforced)
+    printf("instruction budgets measured with: %s\n"
+           "instruction budgets reported, not enforced\n",
+           budget_toolchain[0] ? budget_toolchain : "(none)");
+
+  printf("%-20s %12s %8s %10s %12s %10s\n", "operation", "transactions",
+         "bytes", "bus_us", "instructions", "ns/op");
+
+  for (i = 0; i < BENCH_OPS; i++) {
+    if (bench_run(&bench_ops[i], &metrics[i]) != 0) {
+      fprintf(stderr, "%s: operation failed or wrong result\n",
+              bench_ops[i].name);
+      return 2;
+    }
+    metrics[i].metric[BENCH_INSTRUCTIONS] = bench_instructions(&bench_ops[i]);
+
+    budget[i] = NULL;
+    for (j = 0; j < budget_count; j++) {
+      if (strcmp(budgets[j].name, bench_ops[i].name) == 0) {
+        budget[i] = &budgets[j];
+        budgets[j].used = 1;
+      }
+    }
+
+    pass[i] = (budget[i] != NULL);
+    reported = 0;
+    for (m = 0; pass[i] && (m < BENCH_METRICS); m++) {
+      if ((budget[i]->limit[m] < 0.0) ||
+          (metrics[i].metric[m] <= budget[i]->limit[m]))
+        continue;
+      // Instruction counts are toolchain specific, see the budget file.
+      // Without ptrace they are negative, so never over budget
+      if ((m == BENCH_INSTRUCTIONS) && !enforced) {
+        reported = 1;
+        continue;
+      }
+      pass[i] = 0;
+    }
+    if (metrics[i].metric[BENCH_INSTRUCTIONS] < 0.0)
+      skipped = 1;
+    all_pass &= pass[i];
+
+    printf("%-20s %12.2f %8.2f %10.1f %12.1f %10.1f%s\n", bench_ops[i].name,
+           metrics[i].metric[BENCH_TRANSACTIONS],
+           metrics[i].metric[BENCH_BYTES], metrics[i].metric[BENCH_BUS_US],
+           metrics[i].metric[BENCH_INSTRUCTIONS],
+           metrics[i].metric[BENCH_NS_PER_OP],
+           pass[i] ? (reported ? "  instructions over budget (reported)" : "")
+                   : (budget[i] ? "  OVER BUDGET" : "  NO BUDGET"));
+  }
+
+  for (j = 0; j < budget_count; j++) {
+    if (!budgets[j].used) {
+      printf("budget for unknown operation %s\n", budgets[j].name);
+      all_pass = 0;
+    }
+  }
+
+  if (skipped)
+    printf("ptrace not available: instructions not measured\n");
+
+  all_pass &= bench_fanout_check(metrics);
+
+  printf("codec ratio %.2f (%zu bytes per %u samples)\n",
+         (double)(BENCH_BLOCK * 3U * sizeof(uint32_t)) /
+             (double)bench_packed_len,
+         bench_packed_len, BENCH_BLOCK);
+
+  for (i = 3; i < (uint32_t)argc; i++) {
+    if (bench_stream_run(argv[i], &streams[stream_count]) != 0) {
+      fprintf(stderr, "%s: cannot load or pack stream\n", argv[i]);
+      return 2;
+    }
+    printf("%s: %u samples, ratio %.2f, encode %.1f ns/sample, decode %.1f "
+           "ns/sample%s\n",
+           argv[i], streams[stream_count].samples,
+           (double)(streams[stream_count].samples * 3U * sizeof(uint32_t)) /
+               (double)streams[stream_count].packed,
+           streams[stream_count].encode_ns, streams[stream_count].decode_ns,
+           streams[stream_count].lossless ? "" : "  NOT LOSSLESS");
+    all_pass &= streams[stream_count].lossless;
+    stream_count++;
+  }
+
+  if (argc >= 3) {
+    f = fopen(argv[2], "w");
+    if (f == NULL) {
+      fprintf(stderr, "cannot write %s\n", argv[2]);
+      return 2;
+    }
+    bench_report_json(f, metrics, budget, pass, all_pass, toolchain, enforced,
+                      streams, stream_count);
+    fclose(f);
+  }
+
+  free(bench_ring);
+  for (i = 0; i < 3U; i++)
+    free(bench_fanout_set[i].ring);
+
+  return all_pass ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "i2c_bus.h"
+#include <fcntl.h>
+#include <linux/i2c-dev.h>
+#include <linux/i2c.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+int32_t i2c_bus_open(i2c_bus_t *bus, const char *path, uint16_t addr) {
+  if ((bus == NULL) || (path == NULL))
+    return -1;
+
+  bus->fd = open(path, O_RDWR | O_CLOEXEC);
+  if (bus->fd < 0)
+    return -1;
+  bus->addr = addr;
+
+  return 0;
+}
+
+void i2c_bus_close(i2c_bus_t *bus) {
+  if ((bus != NULL) && (bus->fd >= 0)) {
+    close(bus->fd);
+    bus->fd = -1;
+  }
+}
+
+int32_t i2c_bus_write(void *handle, uint8_t reg, const uint8_t *data,
+                      uint16_t len) {
+  i2c_bus_t *bus = (i2c_bus_t *)handle;
+  uint8_t buf[16];
+  struct i2c_msg msg;
+  struct i2c_rdwr_ioctl_data xfer = {&msg, 1};
+
+  if ((bus == NULL) || (len >= sizeof(buf)))
+    return -1;
+
+  buf[0] = reg;
+  memcpy(&buf[1], data, len);
+  msg.addr = bus->addr;
+  msg.flags = 0;
+  msg.len = (uint16_t)(len + 1U);
+  msg.buf = buf;
+
+  return (ioctl(bus->fd, I2C_RDWR, &xfer) == 1) ? 0 : -1;
+}
+
+int32_t i2c_bus_read(void *handle, uint8_t reg, uint8_t *data, uint16_t len) {
+  i2c_bus_t *bus = (i2c_bus_t *)handle;
+  struct i2c_msg msg[2];
+  struct i2c_rdwr_ioctl_data xfer = {msg, 2};
+
+  if (bus == NULL)
+    return -1;
+
+  // Register address then repeated start read, a single bus transaction
+  msg[0].addr = bus->addr;
+  msg[0].flags = 0;
+  msg[0].len = 1;
+  msg[0].buf = &reg;
+  msg[1].addr = bus->addr;
+  msg[1].flags = I2C_M_RD;
+  msg[1].len = len;
+  msg[1].buf = data;
+
+  return (ioctl(bus->fd, I2C_RDWR, &xfer) == 2) ? 0 : -1;
+}
+
+void i2c_bus_mdelay(uint32_t millisec) {
+  struct timespec ts = {(time_t)(millisec / 1000U),
+                        (long)(millisec % 1000U) * 1000000L};
+
+  nanosleep(&ts, NULL);
+}
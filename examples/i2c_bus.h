@@ -0,0 +1,24 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "mmc5983ma.h"
+
+/** Linux i2c-dev transport, memsicdev_ctx_t.handle points to it */
+typedef struct {
+  int fd;
+  uint16_t addr;
+} i2c_bus_t;
+
+#define I2C_BUS_MMC5983MA_ADDR 0x30U
+
+int32_t i2c_bus_open(i2c_bus_t *bus, const char *path, uint16_t addr);
+void i2c_bus_close(i2c_bus_t *bus);
+
+int32_t i2c_bus_write(void *handle, uint8_t reg, const uint8_t *data,
+                      uint16_t len);
+int32_t i2c_bus_read(void *handle, uint8_t reg, uint8_t *data, uint16_t len);
+void i2c_bus_mdelay(uint32_t millisec);
+
+#endif
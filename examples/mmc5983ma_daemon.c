@@ -0,0 +1,247 @@
+#define _GNU_SOURCE
+
+#include "i2c_bus.h"
+#include "mmc5983ma.h"
+#include "ring_shm.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+/**
+ * Acquisition daemon: drives every sensor from a single epoll loop and
+ * publishes the samples in a shared memory ring.
+ *
+ *   mmc5983ma_daemon <shm name> <odr hz> <i2c device>...
+ *
+ * The MMC5983MA has a fixed I2C address, so each sensor sits on its own bus
+ * (or mux channel). The host timerfd of each sensor is the only sample
+ * clock: every tick collects the single shot measurement triggered on the
+ * previous tick (once Meas_M_Done is set) and triggers the next one. A
+ * continuous mode sensor would run on its own oscillator and drift against
+ * the timer, repeating or dropping samples. Each sample carries its index
+ * (the tick it was triggered on), so a missed measurement shows up as a gap
+ * to the readers. Readers (see mmc5983ma_reader.c) consume the ring without
+ * any bus access, so the bus load does not depend on the number of
+ * consumers. SIGINT / SIGTERM are turned into an eventfd wake up to leave the
+ * loop.
+ */
+
+#define DAEMON_MAX_SENSORS 8U
+#define DAEMON_MAX_HZ 1000U
+#define DAEMON_RING_CAPACITY 4096U
+#define DAEMON_STOP_TAG UINT32_MAX
+
+typedef struct {
+  i2c_bus_t bus;
+  memsicdev_ctx_t ctx;
+  mmc5983ma_shadow_t shadow;
+  int timer_fd;
+  uint64_t index;  // sample index of the measurement in flight
+  uint64_t missed; // indexes without a sample
+} daemon_sensor_t;
+
+static int daemon_stop_fd = -1;
+
+static void daemon_on_signal(int sig) {
+  uint64_t one = 1;
+
+  (void)sig;
+  if (write(daemon_stop_fd, &one, sizeof(one)) < 0) {
+    // nothing to do, the loop will be stopped by the next signal
+  }
+}
+
+/**
+ * @brief  Widest bandwidth whose measurement time fits in one period
+ *
+ */
+static int32_t daemon_bw_get(uint32_t hz, mmc5983ma_bw_t *bw) {
+  if ((hz == 0) || (hz > DAEMON_MAX_HZ))
+    return -1;
+
+  // Measurement time: 8 ms, 4 ms, 2 ms, 0.5 ms
+  if (hz <= 100)
+    *bw = MMC5983MA_BW_100HZ;
+  else if (hz <= 200)
+    *bw = MMC5983MA_BW_200HZ;
+  else if (hz <= 400)
+    *bw = MMC5983MA_BW_400HZ;
+  else
+    *bw = MMC5983MA_BW_800HZ;
+
+  return 0;
+}
+
+static int32_t daemon_sensor_start(daemon_sensor_t *s, const char *path,
+                                   uint32_t hz) {
+  mmc5983ma_bw_t bw;
+  struct itimerspec period;
+  uint64_t period_ns;
+  uint8_t id;
+
+  if (daemon_bw_get(hz, &bw) != 0)
+    return -1;
+  if (i2c_bus_open(&s->bus, path, I2C_BUS_MMC5983MA_ADDR) != 0)
+    return -1;
+
+  memset(&s->ctx, 0, sizeof(s->ctx));
+  s->ctx.write_reg = i2c_bus_write;
+  s->ctx.read_reg = i2c_bus_read;
+  s->ctx.mdelay = i2c_bus_mdelay;
+  s->ctx.handle = &s->bus;
+  s->index = 0;
+  s->missed = 0;
+
+  if ((mmc5983ma_shadow_bind(&s->ctx, &s->shadow) != 0) ||
+      (mmc5983ma_reset(&s->ctx) != 0) ||
+      (mmc5983ma_device_id_get(&s->ctx, &id) != 0) || (id != MMC5983MA_ID))
+    return -1;
+
+  if ((mmc5983ma_bandwith_set(&s->ctx, bw) != 0) ||
+      (mmc5983ma_auto_sr_set(&s->ctx, 1) != 0))
+    return -1;
+
+  s->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (s->timer_fd < 0)
+    return -1;
+
+  period_ns = 1000000000ULL / hz;
+  period.it_interval.tv_sec = (time_t)(period_ns / 1000000000ULL);
+  period.it_interval.tv_nsec = (long)(period_ns % 1000000000ULL);
+  period.it_value = period.it_interval;
+
+  // First measurement, collected on the first tick
+  if ((mmc5983ma_take_magnetic_field_measurement_set(&s->ctx, 1) != 0) ||
+      (timerfd_settime(s->timer_fd, 0, &period, NULL) != 0))
+    return -1;
+
+  return 0;
+}
+
+/**
+ * @brief  Collect the measurement in flight, trigger the next one
+ *
+ */
+static void daemon_sensor_tick(daemon_sensor_t *s, uint32_t sensor,
+                               uint64_t expirations, mmc5983ma_ring_t *ring) {
+  mmc5983ma_raw_magneto_data_t raw;
+  mmc5983ma_status_t status;
+  uint8_t done = 0x01; // write 1 to clear Meas_M_Done
+
+  if ((mmc5983ma_status_get(&s->ctx, &status) == 0) &&
+      (status.Meas_M_Done == 1U) &&
+      (mmc5983ma_raw_magnetic_field_measurement_get(&s->ctx, &raw) == 0) &&
+      (mmc5983ma_write_reg(&s->ctx, MMC5983MA_STATUS, &done, 1) == 0))
+    mmc5983ma_ring_push(ring, sensor, s->index, &raw);
+  else
+    s->missed++;
+
+  // A late tick covers several periods, their indexes get no sample
+  s->missed += expirations - 1U;
+  s->index += expirations;
+
+  if (mmc5983ma_take_magnetic_field_measurement_set(&s->ctx, 1) != 0)
+    s->missed++;
+}
+
+static void daemon_sensor_stop(daemon_sensor_t *s) {
+  if (s->timer_fd >= 0)
+    close(s->timer_fd);
+  i2c_bus_close(&s->bus);
+}
+
+int main(int argc, char **argv) {
+  static daemon_sensor_t sensors[DAEMON_MAX_SENSORS];
+  struct epoll_event ev;
+  struct epoll_event events[DAEMON_MAX_SENSORS + 1U];
+  mmc5983ma_ring_t *ring;
+  uint64_t expirations;
+  uint32_t count;
+  uint32_t hz;
+  uint32_t i;
+  int epoll_fd;
+  int n;
+  int k;
+  int running = 1;
+  int ret = 1;
+
+  if ((argc < 4) || ((uint32_t)(argc - 3) > DAEMON_MAX_SENSORS)) {
+    fprintf(stderr, "usage: %s <shm name> <odr hz> <i2c device>...\n",
+            argv[0]);
+    return 2;
+  }
+  hz = (uint32_t)strtoul(argv[2], NULL, 10);
+  count = (uint32_t)(argc - 3);
+
+  ring = ring_shm_create(argv[1], DAEMON_RING_CAPACITY);
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  daemon_stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if ((ring == NULL) || (epoll_fd < 0) || (daemon_stop_fd < 0)) {
+    perror("setup");
+    return 1;
+  }
+
+  ev.events = EPOLLIN;
+  ev.data.u32 = DAEMON_STOP_TAG;
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, daemon_stop_fd, &ev) != 0) {
+    perror("epoll_ctl");
+    return 1;
+  }
+  signal(SIGINT, daemon_on_signal);
+  signal(SIGTERM, daemon_on_signal);
+
+  for (i = 0; i < count; i++) {
+    sensors[i].timer_fd = -1;
+    sensors[i].bus.fd = -1;
+  }
+
+  for (i = 0; i < count; i++) {
+    if (daemon_sensor_start(&sensors[i], argv[3 + i], hz) != 0) {
+      fprintf(stderr, "%s: cannot start sensor\n", argv[3 + i]);
+      goto out;
+    }
+    ev.events = EPOLLIN;
+    ev.data.u32 = i;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sensors[i].timer_fd, &ev) != 0) {
+      perror(argv[3 + i]);
+      goto out;
+    }
+  }
+
+  while (running) {
+    n = epoll_wait(epoll_fd, events, (int)(count + 1U), -1);
+    for (k = 0; k < n; k++) {
+      if (events[k].data.u32 == DAEMON_STOP_TAG) {
+        running = 0;
+        continue;
+      }
+
+      i = events[k].data.u32;
+      if (read(sensors[i].timer_fd, &expirations, sizeof(expirations)) ==
+          (ssize_t)sizeof(expirations))
+        daemon_sensor_tick(&sensors[i], i, expirations, ring);
+    }
+  }
+  ret = 0;
+
+out:
+  for (i = 0; i < count; i++) {
+    if (sensors[i].missed != 0)
+      fprintf(stderr, "%s: %llu of %llu samples missed\n", argv[3 + i],
+              (unsigned long long)sensors[i].missed,
+              (unsigned long long)sensors[i].index);
+    daemon_sensor_stop(&sensors[i]);
+  }
+  ring_shm_close(ring);
+  shm_unlink(argv[1]);
+  close(daemon_stop_fd);
+  close(epoll_fd);
+
+  return ret;
+}
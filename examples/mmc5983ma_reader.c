@@ -0,0 +1,56 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "mmc5983ma.h"
+#include "ring_shm.h"
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * Ring consumer: prints the samples published by mmc5983ma_daemon.
+ *
+ *   mmc5983ma_reader <shm name>
+ *
+ * Any number of readers can run at once, none of them touches the bus.
+ * Prints one line per sample: sensor, sample index, field in gauss. A jump
+ * in the index of a sensor is a measurement the daemon missed.
+ */
+
+int main(int argc, char **argv) {
+  const struct timespec idle = {0, 1000000L};
+  const mmc5983ma_ring_t *ring;
+  mmc5983ma_ring_reader_t reader;
+  mmc5983ma_ring_sample_t sample;
+  mmc5983ma_raw_magneto_data_t raw;
+  mmc5983ma_magneto_data_t val;
+  uint64_t lost = 0;
+
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <shm name>\n", argv[0]);
+    return 2;
+  }
+
+  ring = ring_shm_open(argv[1]);
+  if ((ring == NULL) || (mmc5983ma_ring_reader_init(ring, &reader) != 0)) {
+    fprintf(stderr, "%s: no ring\n", argv[1]);
+    return 1;
+  }
+
+  for (;;) {
+    if (mmc5983ma_ring_read(ring, &reader, &sample) != 0) {
+      if (reader.lost != lost) {
+        fprintf(stderr, "lost %llu samples\n",
+                (unsigned long long)(reader.lost - lost));
+        lost = reader.lost;
+      }
+      nanosleep(&idle, NULL);
+      continue;
+    }
+
+    raw.xraw_1 = sample.x;
+    raw.yraw_1 = sample.y;
+    raw.zraw_1 = sample.z;
+    mmc5983ma_magnetic_field_measurement_get(NULL, &raw, &val);
+    printf("%u %llu %.5f %.5f %.5f\n", sample.sensor,
+           (unsigned long long)sample.index, val.x, val.y, val.z);
+  }
+}
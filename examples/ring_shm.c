@@ -0,0 +1,89 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ring_shm.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief  Create (or replace) a shared memory ring
+ *
+ * @param  name      shm object name, e.g. "/mmc5983ma"
+ * @param  capacity  number of samples, must be a power of two
+ * @retval          ring(ptr), NULL on error
+ *
+ */
+mmc5983ma_ring_t *ring_shm_create(const char *name, uint32_t capacity) {
+  size_t size = mmc5983ma_ring_size(capacity);
+  mmc5983ma_ring_t *ring;
+  int fd;
+
+  if (size == 0)
+    return NULL;
+
+  fd = shm_open(name, O_CREAT | O_RDWR | O_TRUNC, 0644);
+  if (fd < 0)
+    return NULL;
+
+  if (ftruncate(fd, (off_t)size) != 0) {
+    close(fd);
+    return NULL;
+  }
+
+  ring = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ring == MAP_FAILED)
+    return NULL;
+
+  if (mmc5983ma_ring_init(ring, capacity) != 0) {
+    munmap(ring, size);
+    return NULL;
+  }
+
+  return ring;
+}
+
+/**
+ * @brief  Map an existing shared memory ring, read only
+ *
+ * @param  name  shm object name
+ * @retval          ring(ptr), NULL on error
+ *
+ */
+const mmc5983ma_ring_t *ring_shm_open(const char *name) {
+  struct stat st;
+  const mmc5983ma_ring_t *ring;
+  int fd;
+
+  fd = shm_open(name, O_RDONLY, 0);
+  if (fd < 0)
+    return NULL;
+
+  if ((fstat(fd, &st) != 0) || ((size_t)st.st_size < sizeof(*ring))) {
+    close(fd);
+    return NULL;
+  }
+
+  ring = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ring == MAP_FAILED)
+    return NULL;
+
+  // Reject an object that does not hold the ring its header describes
+  if (mmc5983ma_ring_size(ring->capacity) != (size_t)st.st_size) {
+    munmap((void *)ring, (size_t)st.st_size);
+    return NULL;
+  }
+
+  return ring;
+}
+
+/**
+ * @brief  Unmap a ring returned by ring_shm_create or ring_shm_open
+ *
+ */
+void ring_shm_close(const mmc5983ma_ring_t *ring) {
+  if (ring != NULL)
+    munmap((void *)ring, mmc5983ma_ring_size(ring->capacity));
+}
@@ -0,0 +1,19 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef RING_SHM_H
+#define RING_SHM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include "mmc5983ma_ring.h"
+
+/**
+ * POSIX shared memory placement of a mmc5983ma_ring_t.
+ *
+ * The producer creates the object, readers map it read only: they keep
+ * their cursor in their own mmc5983ma_ring_reader_t.
+ */
+
+mmc5983ma_ring_t *ring_shm_create(const char *name, uint32_t capacity);
+const mmc5983ma_ring_t *ring_shm_open(const char *name);
+void ring_shm_close(const mmc5983ma_ring_t *ring);
+
+#endif
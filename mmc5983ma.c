@@ -7,6 +7,45 @@ static mmc5983ma_shadow_t mmc_shadow = {.internal_control0 = 0,
                                         .internal_control2 = 0,
                                         .internal_control3 = 0};
 
+/**
+ * @brief  Get the shadow registers of a device
+ *
+ * @param  ctx   read / write interface definitions(ptr)
+ * @retval          ctx->shadow when bound, the driver wide shadow otherwise
+ *
+ */
+static mmc5983ma_shadow_t *mmc5983ma_shadow_get(const memsicdev_ctx_t *ctx) {
+  if ((ctx != NULL) && (ctx->shadow != NULL))
+    return ctx->shadow;
+
+  return &mmc_shadow;
+}
+
+/**
+ * @brief  Give a device its own shadow registers
+ *
+ * Needed as soon as more than one device is driven, otherwise all contexts
+ * share the driver wide shadow. The shadow is cleared, matching the device
+ * state after power up or mmc5983ma_reset.
+ *
+ * @param  ctx   read / write interface definitions(ptr)
+ * @param  val   shadow registers, must outlive ctx(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument
+ *
+ */
+int32_t mmc5983ma_shadow_bind(memsicdev_ctx_t *ctx, mmc5983ma_shadow_t *val) {
+  if ((ctx == NULL) || (val == NULL))
+    return -1;
+
+  val->internal_control0 = 0;
+  val->internal_control1 = 0;
+  val->internal_control2 = 0;
+  val->internal_control3 = 0;
+  ctx->shadow = val;
+
+  return 0;
+}
+
 /**
  * @brief  Read generic device register
  *
@@ -72,22 +111,23 @@ int32_t mmc5983ma_status_get(const memsicdev_ctx_t *ctx,
 int32_t mmc5983ma_reset(const memsicdev_ctx_t *ctx) {
   int32_t ret;
   mmc5983ma_ctrl1_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl1_t *)&mmc_shadow.internal_control1;
+  reg = *(mmc5983ma_ctrl1_t *)&shadow->internal_control1;
 
   reg.sw_reset = 1U;
 
-  mmc_shadow.internal_control1 = *(uint8_t *)&reg;
+  shadow->internal_control1 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_1,
-                            (uint8_t *)&mmc_shadow.internal_control1, 1);
+                            (uint8_t *)&shadow->internal_control1, 1);
   if (ret != 0) {
     return ret;
   }
 
   if (reg.sw_reset == 1) {
     reg.sw_reset = 0;
-    mmc_shadow.internal_control1 = *(uint8_t *)&reg;
+    shadow->internal_control1 = *(uint8_t *)&reg;
 
     ctx->mdelay(15);
   }
@@ -97,15 +137,16 @@ int32_t mmc5983ma_reset(const memsicdev_ctx_t *ctx) {
 int32_t mmc5983ma_bandwith_set(const memsicdev_ctx_t *ctx, mmc5983ma_bw_t val) {
   int32_t ret;
   mmc5983ma_ctrl1_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl1_t *)&mmc_shadow.internal_control1;
+  reg = *(mmc5983ma_ctrl1_t *)&shadow->internal_control1;
 
   reg.bandwidth = (uint8_t)val & 0x03U;
 
-  mmc_shadow.internal_control1 = *(uint8_t *)&reg;
+  shadow->internal_control1 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_1,
-                            (uint8_t *)&mmc_shadow.internal_control1, 1);
+                            (uint8_t *)&shadow->internal_control1, 1);
 
   return ret;
 }
@@ -116,8 +157,9 @@ int32_t mmc5983ma_bandwith_get(const memsicdev_ctx_t *ctx,
     return -1;
   }
   mmc5983ma_ctrl1_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl1_t *)&mmc_shadow.internal_control1;
+  reg = *(mmc5983ma_ctrl1_t *)&shadow->internal_control1;
 
   *val = reg.bandwidth;
 
@@ -127,15 +169,16 @@ int32_t mmc5983ma_bandwith_get(const memsicdev_ctx_t *ctx,
 int32_t mmc5983ma_x_inhibit_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl1_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl1_t *)&mmc_shadow.internal_control1;
+  reg = *(mmc5983ma_ctrl1_t *)&shadow->internal_control1;
 
-  reg.x_inhibit = (uint8_t)val & 0x03U;
+  reg.x_inhibit = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control1 = *(uint8_t *)&reg;
+  shadow->internal_control1 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_1,
-                            (uint8_t *)&mmc_shadow.internal_control1, 1);
+                            (uint8_t *)&shadow->internal_control1, 1);
 
   return ret;
 }
@@ -144,8 +187,9 @@ int32_t mmc5983ma_x_inhibit_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
     return -1;
   }
   mmc5983ma_ctrl1_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl1_t *)&mmc_shadow.internal_control1;
+  reg = *(mmc5983ma_ctrl1_t *)&shadow->internal_control1;
 
   *val = reg.x_inhibit;
 
@@ -155,15 +199,16 @@ int32_t mmc5983ma_x_inhibit_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
 int32_t mmc5983ma_yz_inhibit_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl1_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl1_t *)&mmc_shadow.internal_control1;
+  reg = *(mmc5983ma_ctrl1_t *)&shadow->internal_control1;
 
   reg.yz_inhibit = (uint8_t)val & 0x03U;
 
-  mmc_shadow.internal_control1 = *(uint8_t *)&reg;
+  shadow->internal_control1 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_1,
-                            (uint8_t *)&mmc_shadow.internal_control1, 1);
+                            (uint8_t *)&shadow->internal_control1, 1);
 
   return ret;
 }
@@ -173,8 +218,9 @@ int32_t mmc5983ma_yz_inhibit_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
     return -1;
   }
   mmc5983ma_ctrl1_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl1_t *)&mmc_shadow.internal_control1;
+  reg = *(mmc5983ma_ctrl1_t *)&shadow->internal_control1;
 
   *val = reg.yz_inhibit;
 
@@ -184,15 +230,16 @@ int32_t mmc5983ma_yz_inhibit_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
 int32_t mmc5983ma_meas_done_int_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl0_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl0_t *)&mmc_shadow.internal_control0;
+  reg = *(mmc5983ma_ctrl0_t *)&shadow->internal_control0;
 
   reg.int_meas_done_en = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control0 = *(uint8_t *)&reg;
+  shadow->internal_control0 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_0,
-                            (uint8_t *)&mmc_shadow.internal_control0, 1);
+                            (uint8_t *)&shadow->internal_control0, 1);
 
   return ret;
 }
@@ -202,8 +249,9 @@ int32_t mmc5983ma_meas_done_int_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
     return -1;
   }
   mmc5983ma_ctrl0_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl0_t *)&mmc_shadow.internal_control0;
+  reg = *(mmc5983ma_ctrl0_t *)&shadow->internal_control0;
 
   *val = reg.int_meas_done_en;
 
@@ -215,19 +263,20 @@ mmc5983ma_take_magnetic_field_measurement_set(const memsicdev_ctx_t *ctx,
                                               uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl0_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl0_t *)&mmc_shadow.internal_control0;
+  reg = *(mmc5983ma_ctrl0_t *)&shadow->internal_control0;
 
   reg.tm_m = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control0 = *(uint8_t *)&reg;
+  shadow->internal_control0 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_0,
-                            (uint8_t *)&mmc_shadow.internal_control0, 1);
+                            (uint8_t *)&shadow->internal_control0, 1);
 
   if (reg.tm_m == 1) {
     reg.tm_m = 0;
-    mmc_shadow.internal_control0 = *(uint8_t *)&reg;
+    shadow->internal_control0 = *(uint8_t *)&reg;
   }
   return ret;
 }
@@ -236,19 +285,20 @@ int32_t mmc5983ma_take_temperature_measurement_set(const memsicdev_ctx_t *ctx,
                                                    uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl0_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl0_t *)&mmc_shadow.internal_control0;
+  reg = *(mmc5983ma_ctrl0_t *)&shadow->internal_control0;
 
   reg.tm_t = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control0 = *(uint8_t *)&reg;
+  shadow->internal_control0 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_0,
-                            (uint8_t *)&mmc_shadow.internal_control0, 1);
+                            (uint8_t *)&shadow->internal_control0, 1);
 
   if (reg.tm_t == 1) {
     reg.tm_t = 0;
-    mmc_shadow.internal_control0 = *(uint8_t *)&reg;
+    shadow->internal_control0 = *(uint8_t *)&reg;
   }
   return ret;
 }
@@ -256,15 +306,16 @@ int32_t mmc5983ma_take_temperature_measurement_set(const memsicdev_ctx_t *ctx,
 int32_t mmc5983ma_auto_sr_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl0_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl0_t *)&mmc_shadow.internal_control0;
+  reg = *(mmc5983ma_ctrl0_t *)&shadow->internal_control0;
 
   reg.auto_sr_en = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control0 = *(uint8_t *)&reg;
+  shadow->internal_control0 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_0,
-                            (uint8_t *)&mmc_shadow.internal_control0, 1);
+                            (uint8_t *)&shadow->internal_control0, 1);
 
   return ret;
 }
@@ -273,8 +324,9 @@ int32_t mmc5983ma_auto_sr_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
     return -1;
   }
   mmc5983ma_ctrl0_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl0_t *)&mmc_shadow.internal_control0;
+  reg = *(mmc5983ma_ctrl0_t *)&shadow->internal_control0;
 
   *val = reg.auto_sr_en;
 
@@ -284,38 +336,40 @@ int32_t mmc5983ma_auto_sr_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
 int32_t mmc5983ma_set_operation_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl0_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl0_t *)&mmc_shadow.internal_control0;
+  reg = *(mmc5983ma_ctrl0_t *)&shadow->internal_control0;
 
   reg.set = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control0 = *(uint8_t *)&reg;
+  shadow->internal_control0 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_0,
-                            (uint8_t *)&mmc_shadow.internal_control0, 1);
+                            (uint8_t *)&shadow->internal_control0, 1);
 
   if (reg.set == 1) {
     reg.set = 0;
-    mmc_shadow.internal_control0 = *(uint8_t *)&reg;
+    shadow->internal_control0 = *(uint8_t *)&reg;
   }
   return ret;
 }
 int32_t mmc5983ma_reset_operation_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl0_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl0_t *)&mmc_shadow.internal_control0;
+  reg = *(mmc5983ma_ctrl0_t *)&shadow->internal_control0;
 
   reg.reset = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control0 = *(uint8_t *)&reg;
+  shadow->internal_control0 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_0,
-                            (uint8_t *)&mmc_shadow.internal_control0, 1);
+                            (uint8_t *)&shadow->internal_control0, 1);
 
   if (reg.reset == 1) {
     reg.reset = 0;
-    mmc_shadow.internal_control0 = *(uint8_t *)&reg;
+    shadow->internal_control0 = *(uint8_t *)&reg;
   }
   return ret;
 }
@@ -324,15 +378,16 @@ int32_t mmc5983ma_cm_freq_set(const memsicdev_ctx_t *ctx,
                               mmc5983ma_continuous_mode_freq_t val) {
   int32_t ret;
   mmc5983ma_ctrl2_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl2_t *)&mmc_shadow.internal_control2;
+  reg = *(mmc5983ma_ctrl2_t *)&shadow->internal_control2;
 
-  reg.cm_freq = (uint8_t)val & 0x06U;
+  reg.cm_freq = (uint8_t)val & 0x07U;
 
-  mmc_shadow.internal_control2 = *(uint8_t *)&reg;
+  shadow->internal_control2 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_2,
-                            (uint8_t *)&mmc_shadow.internal_control2, 1);
+                            (uint8_t *)&shadow->internal_control2, 1);
 
   return ret;
 }
@@ -342,8 +397,9 @@ int32_t mmc5983ma_cm_freq_get(const memsicdev_ctx_t *ctx,
     return -1;
   }
   mmc5983ma_ctrl2_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl2_t *)&mmc_shadow.internal_control1;
+  reg = *(mmc5983ma_ctrl2_t *)&shadow->internal_control2;
 
   *val = reg.cm_freq;
 
@@ -353,15 +409,16 @@ int32_t mmc5983ma_cm_freq_get(const memsicdev_ctx_t *ctx,
 int32_t mmc5983ma_cmm_en_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl2_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl2_t *)&mmc_shadow.internal_control2;
+  reg = *(mmc5983ma_ctrl2_t *)&shadow->internal_control2;
 
   reg.cmm_en = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control2 = *(uint8_t *)&reg;
+  shadow->internal_control2 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_2,
-                            (uint8_t *)&mmc_shadow.internal_control2, 1);
+                            (uint8_t *)&shadow->internal_control2, 1);
 
   return ret;
 }
@@ -371,8 +428,9 @@ int32_t mmc5983ma_cmm_en_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
     return -1;
   }
   mmc5983ma_ctrl2_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl2_t *)&mmc_shadow.internal_control2;
+  reg = *(mmc5983ma_ctrl2_t *)&shadow->internal_control2;
 
   *val = reg.cmm_en;
 
@@ -382,15 +440,16 @@ int32_t mmc5983ma_cmm_en_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
 int32_t mmc5983ma_prd_set_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl2_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl2_t *)&mmc_shadow.internal_control2;
+  reg = *(mmc5983ma_ctrl2_t *)&shadow->internal_control2;
 
-  reg.prd_set = (uint8_t)val & 0x06U;
+  reg.prd_set = (uint8_t)val & 0x07U;
 
-  mmc_shadow.internal_control2 = *(uint8_t *)&reg;
+  shadow->internal_control2 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_2,
-                            (uint8_t *)&mmc_shadow.internal_control2, 1);
+                            (uint8_t *)&shadow->internal_control2, 1);
 
   return ret;
 }
@@ -400,8 +459,9 @@ int32_t mmc5983ma_prd_set_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
     return -1;
   }
   mmc5983ma_ctrl2_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl2_t *)&mmc_shadow.internal_control2;
+  reg = *(mmc5983ma_ctrl2_t *)&shadow->internal_control2;
 
   *val = reg.prd_set;
 
@@ -411,15 +471,16 @@ int32_t mmc5983ma_prd_set_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
 int32_t mmc5983ma_en_prd_set_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl2_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl2_t *)&mmc_shadow.internal_control2;
+  reg = *(mmc5983ma_ctrl2_t *)&shadow->internal_control2;
 
   reg.en_prd_set = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control2 = *(uint8_t *)&reg;
+  shadow->internal_control2 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_2,
-                            (uint8_t *)&mmc_shadow.internal_control2, 1);
+                            (uint8_t *)&shadow->internal_control2, 1);
 
   return ret;
 }
@@ -429,8 +490,9 @@ int32_t mmc5983ma_en_prd_set_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
     return -1;
   }
   mmc5983ma_ctrl2_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl2_t *)&mmc_shadow.internal_control2;
+  reg = *(mmc5983ma_ctrl2_t *)&shadow->internal_control2;
 
   *val = reg.en_prd_set;
 
@@ -440,15 +502,16 @@ int32_t mmc5983ma_en_prd_set_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
 int32_t mmc5983ma_set_enp_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl3_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl3_t *)&mmc_shadow.internal_control3;
+  reg = *(mmc5983ma_ctrl3_t *)&shadow->internal_control3;
 
   reg.st_enp = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control3 = *(uint8_t *)&reg;
+  shadow->internal_control3 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_3,
-                            (uint8_t *)&mmc_shadow.internal_control3, 1);
+                            (uint8_t *)&shadow->internal_control3, 1);
 
   return ret;
 }
@@ -458,8 +521,9 @@ int32_t mmc5983ma_set_enp_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
     return -1;
   }
   mmc5983ma_ctrl3_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl3_t *)&mmc_shadow.internal_control2;
+  reg = *(mmc5983ma_ctrl3_t *)&shadow->internal_control3;
 
   *val = reg.st_enp;
 
@@ -469,15 +533,16 @@ int32_t mmc5983ma_set_enp_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
 int32_t mmc5983ma_set_enm_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl3_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl3_t *)&mmc_shadow.internal_control3;
+  reg = *(mmc5983ma_ctrl3_t *)&shadow->internal_control3;
 
   reg.st_enm = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control3 = *(uint8_t *)&reg;
+  shadow->internal_control3 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_3,
-                            (uint8_t *)&mmc_shadow.internal_control3, 1);
+                            (uint8_t *)&shadow->internal_control3, 1);
 
   return ret;
 }
@@ -486,8 +551,9 @@ int32_t mmc5983ma_set_enm_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
     return -1;
   }
   mmc5983ma_ctrl3_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl3_t *)&mmc_shadow.internal_control2;
+  reg = *(mmc5983ma_ctrl3_t *)&shadow->internal_control3;
 
   *val = reg.st_enm;
 
@@ -497,15 +563,16 @@ int32_t mmc5983ma_set_enm_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
 int32_t mmc5983ma_spi_3w_set(const memsicdev_ctx_t *ctx, uint8_t val) {
   int32_t ret;
   mmc5983ma_ctrl3_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl3_t *)&mmc_shadow.internal_control3;
+  reg = *(mmc5983ma_ctrl3_t *)&shadow->internal_control3;
 
   reg.spi_3w = (uint8_t)val & 0x01U;
 
-  mmc_shadow.internal_control3 = *(uint8_t *)&reg;
+  shadow->internal_control3 = *(uint8_t *)&reg;
 
   ret = mmc5983ma_write_reg(ctx, MMC5983MA_INTERNAL_CTRL_3,
-                            (uint8_t *)&mmc_shadow.internal_control3, 1);
+                            (uint8_t *)&shadow->internal_control3, 1);
 
   return ret;
 }
@@ -514,8 +581,9 @@ int32_t mmc5983ma_spi_3w_get(const memsicdev_ctx_t *ctx, uint8_t *val) {
     return -1;
   }
   mmc5983ma_ctrl3_t reg;
+  mmc5983ma_shadow_t *shadow = mmc5983ma_shadow_get(ctx);
 
-  reg = *(mmc5983ma_ctrl3_t *)&mmc_shadow.internal_control2;
+  reg = *(mmc5983ma_ctrl3_t *)&shadow->internal_control3;
 
   *val = reg.spi_3w;
 
@@ -527,8 +595,9 @@ int32_t mmc5983ma_raw_magnetic_field_measurement_get(
 
   int32_t ret;
 
+  // Output registers only (XOUT_0 .. TOUT), in a single burst
   ret = mmc5983ma_read_reg(ctx, MMC5983MA_XOUT_0, (uint8_t *)val,
-                           sizeof(mmc5983ma_raw_magneto_data_t));
+                           MMC5983MA_TOUT - MMC5983MA_XOUT_0 + 1);
 
   val->xraw_1 = (val->xout0 << 10) | (val->xout1 << 2) |
                 ((val->xyzout2 & 0b11000000) >> 6);
@@ -544,6 +613,7 @@ int32_t
 mmc5983ma_magnetic_field_measurement_get(const memsicdev_ctx_t *ctx,
                                          mmc5983ma_raw_magneto_data_t *raw,
                                          mmc5983ma_magneto_data_t *val) {
+  (void)ctx;
 
   val->x = -8.f + ((float)(raw->xraw_1) * 0.0625f) / 1e3f;
   val->y = -8.f + ((float)(raw->yraw_1) * 0.0625f) / 1e3f;
@@ -551,3 +621,21 @@ mmc5983ma_magnetic_field_measurement_get(const memsicdev_ctx_t *ctx,
 
   return 0;
 }
+
+int32_t mmc5983ma_magnetic_field_measurement_batch_get(
+    const mmc5983ma_raw_magneto_data_t *raw, mmc5983ma_magneto_data_t *val,
+    uint16_t count) {
+  uint16_t i;
+
+  if ((raw == NULL) || (val == NULL)) {
+    return -1;
+  }
+
+  for (i = 0; i < count; i++) {
+    val[i].x = -8.f + ((float)(raw[i].xraw_1) * 0.0625f) / 1e3f;
+    val[i].y = -8.f + ((float)(raw[i].yraw_1) * 0.0625f) / 1e3f;
+    val[i].z = -8.f + ((float)(raw[i].zraw_1) * 0.0625f) / 1e3f;
+  }
+
+  return 0;
+}
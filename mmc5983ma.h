@@ -62,7 +62,7 @@ typedef struct {
 } mmc5983ma_ctrl2_t; // order inverse little endian
 
 typedef struct {
-  uint8_t reserved_01 : 2;
+  uint8_t reserved_01 : 1;
   uint8_t st_enp : 1;
   uint8_t st_enm : 1;
   uint8_t reserved__02 : 3;
@@ -84,10 +84,11 @@ typedef enum {
   MMC5983MA_CONTINIOUS_MODE_FREQ_0HZ = 0x00,
   MMC5983MA_CONTINIOUS_MODE_FREQ_1HZ = 0x01,
   MMC5983MA_CONTINIOUS_MODE_FREQ_10HZ = 0x02,
-  MMC5983MA_CONTINIOUS_MODE_FREQ_50HZ = 0x03,
-  MMC5983MA_CONTINIOUS_MODE_FREQ_100HZ = 0x03,
-  MMC5983MA_CONTINIOUS_MODE_FREQ_200HZ = 0x03,
-  MMC5983MA_CONTINIOUS_MODE_FREQ_1000HZ = 0x03,
+  MMC5983MA_CONTINIOUS_MODE_FREQ_20HZ = 0x03,
+  MMC5983MA_CONTINIOUS_MODE_FREQ_50HZ = 0x04,
+  MMC5983MA_CONTINIOUS_MODE_FREQ_100HZ = 0x05,
+  MMC5983MA_CONTINIOUS_MODE_FREQ_200HZ = 0x06,  // requires MMC5983MA_BW_200HZ
+  MMC5983MA_CONTINIOUS_MODE_FREQ_1000HZ = 0x07, // requires MMC5983MA_BW_800HZ
 
 } mmc5983ma_continuous_mode_freq_t;
 
@@ -147,8 +148,13 @@ typedef struct {
 
   /** private data **/
   void *priv_data;
+
+  /** Optional per device shadow registers, see mmc5983ma_shadow_bind **/
+  mmc5983ma_shadow_t *shadow;
 } memsicdev_ctx_t;
 
+int32_t mmc5983ma_shadow_bind(memsicdev_ctx_t *ctx, mmc5983ma_shadow_t *val);
+
 int32_t mmc5983ma_read_reg(const memsicdev_ctx_t *ctx, uint8_t reg,
                            uint8_t *data, uint16_t len);
 int32_t mmc5983ma_write_reg(const memsicdev_ctx_t *ctx, uint8_t reg,
@@ -223,6 +229,9 @@ int32_t
 mmc5983ma_magnetic_field_measurement_get(const memsicdev_ctx_t *ctx,
                                          mmc5983ma_raw_magneto_data_t *raw,
                                          mmc5983ma_magneto_data_t *val);
+int32_t mmc5983ma_magnetic_field_measurement_batch_get(
+    const mmc5983ma_raw_magneto_data_t *raw, mmc5983ma_magneto_data_t *val,
+    uint16_t count);
 #ifdef __cplusplus
 }
 #endif
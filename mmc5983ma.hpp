@@ -0,0 +1,263 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MMC5983MA_HPP
+#define MMC5983MA_HPP
+
+/* Includes ------------------------------------------------------------------*/
+#include "mmc5983ma.h"
+
+/**
+ * Header only C++ binding of the driver.
+ *
+ * The bus is a policy type instead of the memsicdev_ctx_t function
+ * pointers, so register addresses, lengths and field masks are compile time
+ * constants and the whole access path can be inlined. A policy provides:
+ *
+ *   int32_t write(uint8_t reg, const uint8_t *data, uint16_t len);
+ *   int32_t read(uint8_t reg, uint8_t *data, uint16_t len);
+ *   void mdelay(uint32_t millisec);
+ *
+ * defined in the class body (implicitly inline). I2C, SPI or mock policies
+ * only differ in these three functions. Return codes follow the C driver:
+ * 0 -> no Error.
+ */
+
+namespace mmc5983ma {
+
+/** Bit field of an 8-bit register, LSB first like the C bit field structs */
+template <uint8_t Shift, uint8_t Width> struct field {
+  static constexpr uint8_t mask =
+      static_cast<uint8_t>(((1U << Width) - 1U) << Shift);
+
+  static constexpr uint8_t set(uint8_t reg, uint8_t val) {
+    return static_cast<uint8_t>((reg & ~mask) | ((val << Shift) & mask));
+  }
+  static constexpr uint8_t get(uint8_t reg) {
+    return static_cast<uint8_t>((reg & mask) >> Shift);
+  }
+};
+
+// internal 0
+typedef field<0, 1> tm_m;
+typedef field<1, 1> tm_t;
+typedef field<2, 1> int_meas_done_en;
+typedef field<3, 1> set;
+typedef field<4, 1> reset;
+typedef field<5, 1> auto_sr_en;
+
+// internal 1
+typedef field<0, 2> bandwidth;
+typedef field<2, 1> x_inhibit;
+typedef field<3, 2> yz_inhibit;
+typedef field<7, 1> sw_reset;
+
+// internal 2
+typedef field<0, 3> cm_freq;
+typedef field<3, 1> cmm_en;
+typedef field<4, 3> prd_set;
+typedef field<7, 1> en_prd_set;
+
+// internal 3
+typedef field<1, 1> st_enp;
+typedef field<2, 1> st_enm;
+typedef field<6, 1> spi_3w;
+
+/** 18-bit output of one axis from the output registers */
+constexpr uint32_t raw_axis(uint8_t out0, uint8_t out1, uint8_t out2,
+                            uint8_t shift) {
+  return (static_cast<uint32_t>(out0) << 10) |
+         (static_cast<uint32_t>(out1) << 2) |
+         ((static_cast<uint32_t>(out2) >> shift) & 0x03U);
+}
+
+/** Same scale as mmc5983ma_magnetic_field_measurement_get, in gauss */
+constexpr float gauss(uint32_t raw) {
+  return -8.f + (static_cast<float>(raw) * 0.0625f) / 1e3f;
+}
+
+template <class Bus> class device {
+public:
+  explicit device(const Bus &bus = Bus()) : bus_(bus), shadow_() {}
+
+  Bus &bus() { return bus_; }
+  const mmc5983ma_shadow_t &shadow() const { return shadow_; }
+
+  int32_t device_id_get(uint8_t *val) {
+    return bus_.read(MMC5983MA_WHO_AM_I, val, 1);
+  }
+
+  int32_t status_get(mmc5983ma_status_t *val) {
+    return bus_.read(MMC5983MA_STATUS, reinterpret_cast<uint8_t *>(val), 1);
+  }
+
+  int32_t reset() {
+    int32_t ret = pulse<MMC5983MA_INTERNAL_CTRL_1, sw_reset>(
+        shadow_.internal_control1);
+    if (ret == 0)
+      bus_.mdelay(15);
+    return ret;
+  }
+
+  // internal 0
+  int32_t meas_done_int_set(uint8_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_0, int_meas_done_en>(
+        shadow_.internal_control0, val);
+  }
+  int32_t meas_done_int_get(uint8_t *val) const {
+    return extract<int_meas_done_en>(shadow_.internal_control0, val);
+  }
+  int32_t auto_sr_set(uint8_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_0, auto_sr_en>(
+        shadow_.internal_control0, val);
+  }
+  int32_t auto_sr_get(uint8_t *val) const {
+    return extract<auto_sr_en>(shadow_.internal_control0, val);
+  }
+  int32_t take_magnetic_field_measurement() {
+    return pulse<MMC5983MA_INTERNAL_CTRL_0, tm_m>(shadow_.internal_control0);
+  }
+  int32_t take_temperature_measurement() {
+    return pulse<MMC5983MA_INTERNAL_CTRL_0, tm_t>(shadow_.internal_control0);
+  }
+  int32_t set_operation() {
+    return pulse<MMC5983MA_INTERNAL_CTRL_0, set>(shadow_.internal_control0);
+  }
+  int32_t reset_operation() {
+    return pulse<MMC5983MA_INTERNAL_CTRL_0, mmc5983ma::reset>(
+        shadow_.internal_control0);
+  }
+
+  // internal 1
+  int32_t bandwith_set(mmc5983ma_bw_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_1, bandwidth>(
+        shadow_.internal_control1, static_cast<uint8_t>(val));
+  }
+  int32_t bandwith_get(mmc5983ma_bw_t *val) const {
+    if (val == nullptr)
+      return -1;
+    *val = static_cast<mmc5983ma_bw_t>(
+        bandwidth::get(shadow_.internal_control1));
+    return 0;
+  }
+  int32_t x_inhibit_set(uint8_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_1, x_inhibit>(
+        shadow_.internal_control1, val);
+  }
+  int32_t x_inhibit_get(uint8_t *val) const {
+    return extract<x_inhibit>(shadow_.internal_control1, val);
+  }
+  int32_t yz_inhibit_set(uint8_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_1, yz_inhibit>(
+        shadow_.internal_control1, val);
+  }
+  int32_t yz_inhibit_get(uint8_t *val) const {
+    return extract<yz_inhibit>(shadow_.internal_control1, val);
+  }
+
+  // internal 2
+  int32_t cm_freq_set(mmc5983ma_continuous_mode_freq_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_2, cm_freq>(
+        shadow_.internal_control2, static_cast<uint8_t>(val));
+  }
+  int32_t cm_freq_get(mmc5983ma_continuous_mode_freq_t *val) const {
+    if (val == nullptr)
+      return -1;
+    *val = static_cast<mmc5983ma_continuous_mode_freq_t>(
+        cm_freq::get(shadow_.internal_control2));
+    return 0;
+  }
+  int32_t cmm_en_set(uint8_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_2, cmm_en>(
+        shadow_.internal_control2, val);
+  }
+  int32_t cmm_en_get(uint8_t *val) const {
+    return extract<cmm_en>(shadow_.internal_control2, val);
+  }
+  int32_t prd_set_set(uint8_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_2, prd_set>(
+        shadow_.internal_control2, val);
+  }
+  int32_t prd_set_get(uint8_t *val) const {
+    return extract<prd_set>(shadow_.internal_control2, val);
+  }
+  int32_t en_prd_set_set(uint8_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_2, en_prd_set>(
+        shadow_.internal_control2, val);
+  }
+  int32_t en_prd_set_get(uint8_t *val) const {
+    return extract<en_prd_set>(shadow_.internal_control2, val);
+  }
+
+  // internal 3
+  int32_t set_enp_set(uint8_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_3, st_enp>(
+        shadow_.internal_control3, val);
+  }
+  int32_t set_enp_get(uint8_t *val) const {
+    return extract<st_enp>(shadow_.internal_control3, val);
+  }
+  int32_t set_enm_set(uint8_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_3, st_enm>(
+        shadow_.internal_control3, val);
+  }
+  int32_t set_enm_get(uint8_t *val) const {
+    return extract<st_enm>(shadow_.internal_control3, val);
+  }
+  int32_t spi_3w_set(uint8_t val) {
+    return update<MMC5983MA_INTERNAL_CTRL_3, spi_3w>(
+        shadow_.internal_control3, val);
+  }
+  int32_t spi_3w_get(uint8_t *val) const {
+    return extract<spi_3w>(shadow_.internal_control3, val);
+  }
+
+  // data register
+  int32_t raw_magnetic_field_measurement_get(mmc5983ma_raw_magneto_data_t &raw) {
+    int32_t ret = bus_.read(MMC5983MA_XOUT_0,
+                            reinterpret_cast<uint8_t *>(&raw),
+                            MMC5983MA_TOUT - MMC5983MA_XOUT_0 + 1);
+
+    raw.xraw_1 = raw_axis(raw.xout0, raw.xout1, raw.xyzout2, 6);
+    raw.yraw_1 = raw_axis(raw.yout0, raw.yout1, raw.xyzout2, 4);
+    raw.zraw_1 = raw_axis(raw.zout0, raw.zout1, raw.xyzout2, 2);
+
+    return ret;
+  }
+
+  // Conversion only, like the C function: no bus access
+  int32_t magnetic_field_measurement_get(const mmc5983ma_raw_magneto_data_t &raw,
+                                         mmc5983ma_magneto_data_t &val) const {
+    val.x = gauss(raw.xraw_1);
+    val.y = gauss(raw.yraw_1);
+    val.z = gauss(raw.zraw_1);
+
+    return 0;
+  }
+
+private:
+  template <uint8_t Reg, class Field>
+  int32_t update(uint8_t &shadow, uint8_t val) {
+    shadow = Field::set(shadow, val);
+    return bus_.write(Reg, &shadow, 1);
+  }
+
+  template <class Field>
+  static int32_t extract(uint8_t shadow, uint8_t *val) {
+    if (val == nullptr)
+      return -1;
+    *val = Field::get(shadow);
+    return 0;
+  }
+
+  // Self clearing bit: written once, never kept in the shadow
+  template <uint8_t Reg, class Field> int32_t pulse(uint8_t &shadow) {
+    uint8_t reg = Field::set(shadow, 1);
+    return bus_.write(Reg, &reg, 1);
+  }
+
+  Bus bus_;
+  mmc5983ma_shadow_t shadow_;
+};
+
+} // namespace mmc5983ma
+
+#endif
@@ -0,0 +1,200 @@
+#include "mmc5983ma_allan.h"
+#include <stdint.h>
+
+// Same scale as mmc5983ma_magnetic_field_measurement_get (gauss per count)
+#define ALLAN_GAUSS_PER_COUNT (0.0625f / 1e3f)
+
+// Pairs needed before a level is trusted for the bias instability search
+#define ALLAN_MIN_PAIRS 8U
+
+// Flicker floor of the Allan deviation: sigma_min = 0.664 * B
+#define ALLAN_FLICKER_FACTOR 0.664f
+
+/**
+ * @brief  Allan deviation of one axis of a level, in gauss
+ *
+ */
+static float mmc5983ma_allan_level_adev(const mmc5983ma_allan_level_t *lvl,
+                                        uint8_t axis) {
+  return (float)sqrt(lvl->acc[axis] / (2.0 * (double)lvl->pairs)) *
+         ALLAN_GAUSS_PER_COUNT;
+}
+
+/**
+ * @brief  Initialise the estimator
+ *
+ * @param  allan          estimator state(ptr)
+ * @param  sample_period  time between two pushed samples, in s
+ * @retval          0 -> no Error, -1 -> invalid argument
+ *
+ */
+int32_t mmc5983ma_allan_init(mmc5983ma_allan_t *allan, float sample_period) {
+  uint8_t i;
+  uint8_t axis;
+
+  if ((allan == NULL) || !(sample_period > 0.f))
+    return -1;
+
+  allan->sample_period = sample_period;
+  allan->samples = 0;
+  for (i = 0; i < MMC5983MA_ALLAN_LEVELS; i++) {
+    for (axis = 0; axis < 3U; axis++) {
+      allan->level[i].pending[axis] = 0;
+      allan->level[i].prev[axis] = 0;
+      allan->level[i].acc[axis] = 0.0;
+    }
+    allan->level[i].pairs = 0;
+    allan->level[i].has_pending = 0;
+    allan->level[i].has_prev = 0;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief  Feed one raw sample
+ *
+ * @param  allan  estimator state(ptr)
+ * @param  raw    sample as returned by
+ *                mmc5983ma_raw_magnetic_field_measurement_get(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument
+ *
+ */
+int32_t mmc5983ma_allan_push(mmc5983ma_allan_t *allan,
+                             const mmc5983ma_raw_magneto_data_t *raw) {
+  int64_t sum[3];
+  double d;
+  uint8_t i;
+  uint8_t axis;
+  mmc5983ma_allan_level_t *lvl;
+
+  if ((allan == NULL) || (raw == NULL))
+    return -1;
+
+  sum[0] = raw->xraw_1;
+  sum[1] = raw->yraw_1;
+  sum[2] = raw->zraw_1;
+  allan->samples++;
+
+  // Carry the completed cluster up the levels while it pairs with a pending
+  // one; level i+1 is reached every 2^(i+1) samples only.
+  for (i = 0; i < MMC5983MA_ALLAN_LEVELS; i++) {
+    lvl = &allan->level[i];
+
+    if (lvl->has_prev) {
+      for (axis = 0; axis < 3U; axis++) {
+        d = ldexp((double)(sum[axis] - lvl->prev[axis]), -(int)i);
+        lvl->acc[axis] += d * d;
+      }
+      lvl->pairs++;
+    }
+    for (axis = 0; axis < 3U; axis++)
+      lvl->prev[axis] = sum[axis];
+    lvl->has_prev = 1;
+
+    if (!lvl->has_pending) {
+      for (axis = 0; axis < 3U; axis++)
+        lvl->pending[axis] = sum[axis];
+      lvl->has_pending = 1;
+      break;
+    }
+
+    for (axis = 0; axis < 3U; axis++)
+      sum[axis] += lvl->pending[axis];
+    lvl->has_pending = 0;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief  Allan deviation at one octave
+ *
+ * @param  allan  estimator state(ptr)
+ * @param  level  octave, tau = 2^level * sample period
+ * @param  tau    averaging time in s(ptr)
+ * @param  val    Allan deviation per axis, in gauss(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument or not enough data
+ *
+ */
+int32_t mmc5983ma_allan_deviation_get(const mmc5983ma_allan_t *allan,
+                                      uint8_t level, float *tau,
+                                      mmc5983ma_magneto_data_t *val) {
+  const mmc5983ma_allan_level_t *lvl;
+
+  if ((allan == NULL) || (tau == NULL) || (val == NULL) ||
+      (level >= MMC5983MA_ALLAN_LEVELS))
+    return -1;
+
+  lvl = &allan->level[level];
+  if (lvl->pairs == 0)
+    return -1;
+
+  *tau = ldexpf(allan->sample_period, level);
+  val->x = mmc5983ma_allan_level_adev(lvl, 0);
+  val->y = mmc5983ma_allan_level_adev(lvl, 1);
+  val->z = mmc5983ma_allan_level_adev(lvl, 2);
+
+  return 0;
+}
+
+/**
+ * @brief  Bias instability, from the minimum of the Allan deviation
+ *
+ * @param  allan  estimator state(ptr)
+ * @param  val    bias instability per axis, in gauss(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument or not enough data
+ *
+ */
+int32_t mmc5983ma_allan_bias_instability_get(const mmc5983ma_allan_t *allan,
+                                             mmc5983ma_magneto_data_t *val) {
+  float min[3] = {INFINITY, INFINITY, INFINITY};
+  float adev;
+  uint8_t i;
+  uint8_t axis;
+
+  if ((allan == NULL) || (val == NULL))
+    return -1;
+
+  for (i = 0; i < MMC5983MA_ALLAN_LEVELS; i++) {
+    if (allan->level[i].pairs < ALLAN_MIN_PAIRS)
+      break;
+    for (axis = 0; axis < 3U; axis++) {
+      adev = mmc5983ma_allan_level_adev(&allan->level[i], axis);
+      if (adev < min[axis])
+        min[axis] = adev;
+    }
+  }
+  if (i == 0)
+    return -1;
+
+  val->x = min[0] / ALLAN_FLICKER_FACTOR;
+  val->y = min[1] / ALLAN_FLICKER_FACTOR;
+  val->z = min[2] / ALLAN_FLICKER_FACTOR;
+
+  return 0;
+}
+
+/**
+ * @brief  White noise density, from the shortest averaging time
+ *
+ * @param  allan  estimator state(ptr)
+ * @param  val    noise density per axis, in gauss/sqrt(Hz)(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument or not enough data
+ *
+ */
+int32_t mmc5983ma_allan_noise_density_get(const mmc5983ma_allan_t *allan,
+                                          mmc5983ma_magneto_data_t *val) {
+  float sqrt_tau;
+
+  if ((allan == NULL) || (val == NULL) || (allan->level[0].pairs == 0))
+    return -1;
+
+  // White noise: sigma(tau) = N / sqrt(tau)
+  sqrt_tau = sqrtf(allan->sample_period);
+  val->x = mmc5983ma_allan_level_adev(&allan->level[0], 0) * sqrt_tau;
+  val->y = mmc5983ma_allan_level_adev(&allan->level[0], 1) * sqrt_tau;
+  val->z = mmc5983ma_allan_level_adev(&allan->level[0], 2) * sqrt_tau;
+
+  return 0;
+}
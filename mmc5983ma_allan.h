@@ -0,0 +1,57 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MMC5983MA_ALLAN_H
+#define MMC5983MA_ALLAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "mmc5983ma.h"
+
+/**
+ * Streaming Allan deviation of the raw sample stream.
+ *
+ * Level j averages clusters of 2^j samples (tau = 2^j * sample period).
+ * Every completed cluster is compared with the previous one of its level,
+ * then paired with its neighbour to form a cluster of the next level, like
+ * a binary counter: memory is one accumulator per octave and the work is
+ * O(1) amortized per sample. Sums are kept in raw counts, so they are exact.
+ */
+
+#define MMC5983MA_ALLAN_LEVELS 28U
+
+typedef struct {
+  int64_t pending[3]; // first half of the next cluster of this level
+  int64_t prev[3];    // previous complete cluster
+  double acc[3];      // sum of squared differences of cluster means
+  uint64_t pairs;
+  uint8_t has_pending;
+  uint8_t has_prev;
+} mmc5983ma_allan_level_t;
+
+typedef struct {
+  float sample_period; // s
+  uint64_t samples;
+  mmc5983ma_allan_level_t level[MMC5983MA_ALLAN_LEVELS];
+} mmc5983ma_allan_t;
+
+int32_t mmc5983ma_allan_init(mmc5983ma_allan_t *allan, float sample_period);
+
+int32_t mmc5983ma_allan_push(mmc5983ma_allan_t *allan,
+                             const mmc5983ma_raw_magneto_data_t *raw);
+
+int32_t mmc5983ma_allan_deviation_get(const mmc5983ma_allan_t *allan,
+                                      uint8_t level, float *tau,
+                                      mmc5983ma_magneto_data_t *val);
+
+int32_t mmc5983ma_allan_bias_instability_get(const mmc5983ma_allan_t *allan,
+                                             mmc5983ma_magneto_data_t *val);
+int32_t mmc5983ma_allan_noise_density_get(const mmc5983ma_allan_t *allan,
+                                          mmc5983ma_magneto_data_t *val);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,266 @@
+#include "mmc5983ma_codec.h"
+#include <stdint.h>
+
+#define CODEC_RAW_MASK 0x3FFFFU
+
+typedef struct {
+  uint8_t *buf;
+  size_t size;
+  size_t pos;
+  uint64_t acc;
+  uint32_t bits;
+  uint8_t overflow;
+} codec_writer_t;
+
+typedef struct {
+  const uint8_t *buf;
+  size_t len;
+  size_t pos;
+  uint64_t win; // next bits, MSB aligned
+  uint32_t avail;
+} codec_reader_t;
+
+static void codec_put(codec_writer_t *w, uint32_t val, uint32_t nbits) {
+  w->acc = (w->acc << nbits) | val;
+  w->bits += nbits;
+
+  while (w->bits >= 8U) {
+    w->bits -= 8U;
+    if (w->pos < w->size)
+      w->buf[w->pos] = (uint8_t)(w->acc >> w->bits);
+    else
+      w->overflow = 1;
+    w->pos++;
+  }
+}
+
+static void codec_flush(codec_writer_t *w) {
+  if (w->bits > 0U)
+    codec_put(w, 0, 8U - w->bits);
+}
+
+static void codec_refill(codec_reader_t *r) {
+  while ((r->avail <= 56U) && (r->pos < r->len)) {
+    r->win |= (uint64_t)r->buf[r->pos++] << (56U - r->avail);
+    r->avail += 8U;
+  }
+}
+
+static int32_t codec_get(codec_reader_t *r, uint32_t nbits, uint32_t *val) {
+  if (nbits == 0U) {
+    *val = 0;
+    return 0;
+  }
+  if (r->avail < nbits)
+    return -1;
+
+  *val = (uint32_t)(r->win >> (64U - nbits));
+  r->win <<= nbits;
+  r->avail -= nbits;
+
+  return 0;
+}
+
+static uint32_t codec_leading_ones(uint64_t win) {
+  uint64_t inv = ~win;
+
+  if (inv == 0U)
+    return 64U;
+#if defined(__GNUC__)
+  return (uint32_t)__builtin_clzll(inv);
+#else
+  {
+    uint32_t n = 0;
+    while ((inv & 0x8000000000000000ULL) == 0U) {
+      inv <<= 1;
+      n++;
+    }
+    return n;
+  }
+#endif
+}
+
+static uint32_t codec_zigzag(uint32_t cur, uint32_t prev) {
+  int32_t d = (int32_t)cur - (int32_t)prev;
+
+  return ((uint32_t)d << 1) ^ (uint32_t)(d >> 31);
+}
+
+/**
+ * @brief  Smallest k such that count * 2^k covers the sum of the codes
+ *
+ */
+static uint32_t codec_rice_k(uint64_t sum, uint32_t count) {
+  uint32_t k = 0;
+
+  while ((k < 18U) && (((uint64_t)count << k) < sum))
+    k++;
+
+  return k;
+}
+
+static void codec_put_rice(codec_writer_t *w, uint32_t v, uint32_t k) {
+  uint32_t q = v >> k;
+
+  if (q < MMC5983MA_CODEC_ESCAPE) {
+    codec_put(w, ((1U << q) - 1U) << 1, q + 1U);
+    codec_put(w, v & ((1U << k) - 1U), k);
+  } else {
+    codec_put(w, (1U << MMC5983MA_CODEC_ESCAPE) - 1U, MMC5983MA_CODEC_ESCAPE);
+    codec_put(w, v, 19U);
+  }
+}
+
+static int32_t codec_get_rice(codec_reader_t *r, uint32_t k, uint32_t *val) {
+  uint32_t q;
+  uint32_t low;
+
+  codec_refill(r);
+  q = codec_leading_ones(r->win);
+
+  if (q >= MMC5983MA_CODEC_ESCAPE) {
+    if (codec_get(r, MMC5983MA_CODEC_ESCAPE, &low) != 0)
+      return -1;
+    return codec_get(r, 19U, val);
+  }
+
+  if (codec_get(r, q + 1U, &low) != 0)
+    return -1;
+  if (codec_get(r, k, &low) != 0)
+    return -1;
+
+  *val = (q << k) | low;
+
+  return 0;
+}
+
+/**
+ * @brief  Encode a block of raw samples
+ *
+ * @param  raw    samples, only xraw_1 / yraw_1 / zraw_1 are used(ptr)
+ * @param  count  number of samples, at least 1
+ * @param  buf    output buffer, MMC5983MA_CODEC_BLOCK_BOUND(count) bytes
+ *                always suffice(ptr)
+ * @param  size   size of buf in bytes
+ * @param  len    number of bytes written(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument or buf too small
+ *
+ */
+int32_t mmc5983ma_codec_encode(const mmc5983ma_raw_magneto_data_t *raw,
+                               uint16_t count, uint8_t *buf, size_t size,
+                               size_t *len) {
+  codec_writer_t w = {buf, size, 0, 0, 0, 0};
+  uint64_t sum[3] = {0, 0, 0};
+  uint32_t k[3];
+  uint32_t i;
+
+  if ((raw == NULL) || (buf == NULL) || (len == NULL) || (count == 0U))
+    return -1;
+
+  for (i = 1; i < count; i++) {
+    sum[0] += codec_zigzag(raw[i].xraw_1 & CODEC_RAW_MASK,
+                           raw[i - 1U].xraw_1 & CODEC_RAW_MASK);
+    sum[1] += codec_zigzag(raw[i].yraw_1 & CODEC_RAW_MASK,
+                           raw[i - 1U].yraw_1 & CODEC_RAW_MASK);
+    sum[2] += codec_zigzag(raw[i].zraw_1 & CODEC_RAW_MASK,
+                           raw[i - 1U].zraw_1 & CODEC_RAW_MASK);
+  }
+  for (i = 0; i < 3U; i++)
+    k[i] = codec_rice_k(sum[i], count > 1U ? count - 1U : 1U);
+
+  codec_put(&w, count, 16U);
+  codec_put(&w, raw[0].xraw_1 & CODEC_RAW_MASK, 18U);
+  codec_put(&w, raw[0].yraw_1 & CODEC_RAW_MASK, 18U);
+  codec_put(&w, raw[0].zraw_1 & CODEC_RAW_MASK, 18U);
+  codec_put(&w, k[0], 5U);
+  codec_put(&w, k[1], 5U);
+  codec_put(&w, k[2], 5U);
+
+  for (i = 1; i < count; i++) {
+    codec_put_rice(&w,
+                   codec_zigzag(raw[i].xraw_1 & CODEC_RAW_MASK,
+                                raw[i - 1U].xraw_1 & CODEC_RAW_MASK),
+                   k[0]);
+    codec_put_rice(&w,
+                   codec_zigzag(raw[i].yraw_1 & CODEC_RAW_MASK,
+                                raw[i - 1U].yraw_1 & CODEC_RAW_MASK),
+                   k[1]);
+    codec_put_rice(&w,
+                   codec_zigzag(raw[i].zraw_1 & CODEC_RAW_MASK,
+                                raw[i - 1U].zraw_1 & CODEC_RAW_MASK),
+                   k[2]);
+  }
+  codec_flush(&w);
+
+  if (w.overflow)
+    return -1;
+
+  *len = w.pos;
+
+  return 0;
+}
+
+/**
+ * @brief  Decode a block into raw samples
+ *
+ * The decoded samples feed mmc5983ma_magnetic_field_measurement_batch_get.
+ *
+ * @param  buf    encoded block(ptr)
+ * @param  len    size of the block in bytes
+ * @param  raw    decoded samples, xraw_1 / yraw_1 / zraw_1 are set(ptr)
+ * @param  size   number of entries available in raw
+ * @param  count  number of samples decoded(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument or corrupted block
+ *
+ */
+int32_t mmc5983ma_codec_decode(const uint8_t *buf, size_t len,
+                               mmc5983ma_raw_magneto_data_t *raw,
+                               uint16_t size, uint16_t *count) {
+  codec_reader_t r = {buf, len, 0, 0, 0};
+  uint32_t n;
+  uint32_t k[3];
+  uint32_t v[3];
+  uint32_t i;
+
+  if ((buf == NULL) || (raw == NULL) || (count == NULL))
+    return -1;
+
+  codec_refill(&r);
+  if ((codec_get(&r, 16U, &n) != 0) || (n == 0U) || (n > size))
+    return -1;
+
+  if ((codec_get(&r, 18U, &v[0]) != 0) || (codec_get(&r, 18U, &v[1]) != 0))
+    return -1;
+  codec_refill(&r);
+  if ((codec_get(&r, 18U, &v[2]) != 0) || (codec_get(&r, 5U, &k[0]) != 0) ||
+      (codec_get(&r, 5U, &k[1]) != 0) || (codec_get(&r, 5U, &k[2]) != 0))
+    return -1;
+  if ((k[0] > 18U) || (k[1] > 18U) || (k[2] > 18U))
+    return -1;
+
+  raw[0].xraw_1 = v[0];
+  raw[0].yraw_1 = v[1];
+  raw[0].zraw_1 = v[2];
+
+  for (i = 1; i < n; i++) {
+    if ((codec_get_rice(&r, k[0], &v[0]) != 0) ||
+        (codec_get_rice(&r, k[1], &v[1]) != 0) ||
+        (codec_get_rice(&r, k[2], &v[2]) != 0))
+      return -1;
+
+    // zigzag back to a signed delta, the mask keeps the 18-bit range
+    raw[i].xraw_1 =
+        (raw[i - 1U].xraw_1 + ((v[0] >> 1) ^ (0U - (v[0] & 1U)))) &
+        CODEC_RAW_MASK;
+    raw[i].yraw_1 =
+        (raw[i - 1U].yraw_1 + ((v[1] >> 1) ^ (0U - (v[1] & 1U)))) &
+        CODEC_RAW_MASK;
+    raw[i].zraw_1 =
+        (raw[i - 1U].zraw_1 + ((v[2] >> 1) ^ (0U - (v[2] & 1U)))) &
+        CODEC_RAW_MASK;
+  }
+
+  *count = (uint16_t)n;
+
+  return 0;
+}
@@ -0,0 +1,47 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MMC5983MA_CODEC_H
+#define MMC5983MA_CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "mmc5983ma.h"
+
+/**
+ * Lossless block codec for 18-bit raw samples (xraw_1, yraw_1, zraw_1).
+ *
+ * Block layout, bits are packed MSB first:
+ *   - sample count, 16 bits
+ *   - first sample, 3 x 18 bits
+ *   - Rice parameter of each axis, 3 x 5 bits
+ *   - then for every following sample and axis, the zigzag coded delta to
+ *     the previous sample as a Rice code: (v >> k) ones, a zero, k low bits.
+ *     A run of MMC5983MA_CODEC_ESCAPE ones is followed by v on 19 bits.
+ * The block ends on a byte boundary.
+ */
+
+#define MMC5983MA_CODEC_ESCAPE 24U
+
+/** Worst case encoded size of a block of n samples, in bytes */
+#define MMC5983MA_CODEC_BLOCK_BOUND(n)                                         \
+  ((size_t)(2U + 9U) +                                                         \
+   (((size_t)((n) > 0U ? (n) - 1U : 0U) * 3U *                                 \
+         (MMC5983MA_CODEC_ESCAPE + 19U) +                                      \
+     7U) /                                                                     \
+    8U))
+
+int32_t mmc5983ma_codec_encode(const mmc5983ma_raw_magneto_data_t *raw,
+                               uint16_t count, uint8_t *buf, size_t size,
+                               size_t *len);
+
+int32_t mmc5983ma_codec_decode(const uint8_t *buf, size_t len,
+                               mmc5983ma_raw_magneto_data_t *raw,
+                               uint16_t size, uint16_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,158 @@
+#include "mmc5983ma_ring.h"
+#include <stdint.h>
+
+#define RING_LOAD(p, order) __atomic_load_n((p), (order))
+#define RING_STORE(p, v, order) __atomic_store_n((p), (v), (order))
+
+/**
+ * @brief  Number of bytes needed to hold a ring
+ *
+ * @param  capacity  number of samples, a power of two of at least 2 (a
+ *                   lapped reader resyncs half a ring behind the producer,
+ *                   which must leave the newest sample readable)
+ * @retval          size in bytes, 0 if capacity is not valid
+ *
+ */
+size_t mmc5983ma_ring_size(uint32_t capacity) {
+  if ((capacity < 2U) || ((capacity & (capacity - 1U)) != 0))
+    return 0;
+
+  return sizeof(mmc5983ma_ring_t) +
+         (size_t)capacity * sizeof(mmc5983ma_ring_slot_t);
+}
+
+/**
+ * @brief  Initialise a ring in caller provided (possibly shared) memory
+ *
+ * @param  ring      memory of at least mmc5983ma_ring_size(capacity) bytes
+ * @param  capacity  number of samples, see mmc5983ma_ring_size
+ * @retval          0 -> no Error, -1 -> invalid argument
+ *
+ */
+int32_t mmc5983ma_ring_init(mmc5983ma_ring_t *ring, uint32_t capacity) {
+  uint32_t i;
+
+  if ((ring == NULL) || (mmc5983ma_ring_size(capacity) == 0))
+    return -1;
+
+  ring->capacity = capacity;
+  ring->mask = capacity - 1U;
+  for (i = 0; i < capacity; i++)
+    ring->slot[i].seq = 0;
+
+  RING_STORE(&ring->head, 0, __ATOMIC_RELEASE);
+
+  return 0;
+}
+
+/**
+ * @brief  Publish one sample, never blocks (single producer only)
+ *
+ * @param  ring    ring(ptr)
+ * @param  sensor  index of the sensor the sample comes from
+ * @param  index   sample index of that sensor
+ * @param  raw     sample as returned by
+ *                 mmc5983ma_raw_magnetic_field_measurement_get(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument
+ *
+ */
+int32_t mmc5983ma_ring_push(mmc5983ma_ring_t *ring, uint32_t sensor,
+                            uint64_t index,
+                            const mmc5983ma_raw_magneto_data_t *raw) {
+  uint64_t pos;
+  mmc5983ma_ring_slot_t *slot;
+
+  if ((ring == NULL) || (raw == NULL))
+    return -1;
+
+  pos = RING_LOAD(&ring->head, __ATOMIC_RELAXED);
+  slot = &ring->slot[pos & ring->mask];
+
+  RING_STORE(&slot->seq, 2U * pos + 1U, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+
+  RING_STORE(&slot->sample.index, index, __ATOMIC_RELAXED);
+  RING_STORE(&slot->sample.sensor, sensor, __ATOMIC_RELAXED);
+  RING_STORE(&slot->sample.x, raw->xraw_1, __ATOMIC_RELAXED);
+  RING_STORE(&slot->sample.y, raw->yraw_1, __ATOMIC_RELAXED);
+  RING_STORE(&slot->sample.z, raw->zraw_1, __ATOMIC_RELAXED);
+
+  RING_STORE(&slot->seq, 2U * pos + 2U, __ATOMIC_RELEASE);
+  RING_STORE(&ring->head, pos + 1U, __ATOMIC_RELEASE);
+
+  return 0;
+}
+
+/**
+ * @brief  Attach a reader at the current head (only new samples are seen)
+ *
+ * @param  ring    ring(ptr)
+ * @param  reader  reader state, private to the consumer(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument
+ *
+ */
+int32_t mmc5983ma_ring_reader_init(const mmc5983ma_ring_t *ring,
+                                   mmc5983ma_ring_reader_t *reader) {
+  if ((ring == NULL) || (reader == NULL))
+    return -1;
+
+  reader->cursor = RING_LOAD(&ring->head, __ATOMIC_ACQUIRE);
+  reader->lost = 0;
+
+  return 0;
+}
+
+/**
+ * @brief  Copy the next sample out of the ring, wait-free
+ *
+ * @param  ring    ring(ptr)
+ * @param  reader  reader state(ptr)
+ * @param  val     sample read(ptr)
+ * @retval          0 -> sample read, 1 -> nothing read (ring empty, or the
+ *                  reader was lapped and skipped ahead), -1 -> invalid
+ *                  argument
+ *
+ */
+int32_t mmc5983ma_ring_read(const mmc5983ma_ring_t *ring,
+                            mmc5983ma_ring_reader_t *reader,
+                            mmc5983ma_ring_sample_t *val) {
+  uint64_t head;
+  uint64_t seq;
+  uint64_t pos;
+  const mmc5983ma_ring_slot_t *slot;
+
+  if ((ring == NULL) || (reader == NULL) || (val == NULL))
+    return -1;
+
+  pos = reader->cursor;
+  head = RING_LOAD(&ring->head, __ATOMIC_ACQUIRE);
+  if (pos == head)
+    return 1;
+
+  if (head - pos <= ring->capacity) {
+    slot = &ring->slot[pos & ring->mask];
+
+    seq = RING_LOAD(&slot->seq, __ATOMIC_ACQUIRE);
+    val->index = RING_LOAD(&slot->sample.index, __ATOMIC_RELAXED);
+    val->sensor = RING_LOAD(&slot->sample.sensor, __ATOMIC_RELAXED);
+    val->x = RING_LOAD(&slot->sample.x, __ATOMIC_RELAXED);
+    val->y = RING_LOAD(&slot->sample.y, __ATOMIC_RELAXED);
+    val->z = RING_LOAD(&slot->sample.z, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    if ((seq == 2U * pos + 2U) &&
+        (RING_LOAD(&slot->seq, __ATOMIC_RELAXED) == seq)) {
+      reader->cursor = pos + 1U;
+      return 0;
+    }
+
+    // Slot overwritten while copying it, resync below
+    head = RING_LOAD(&ring->head, __ATOMIC_ACQUIRE);
+  }
+
+  // Lapped: restart half a ring behind the producer to leave it some slack
+  reader->cursor = head - (ring->capacity >> 1);
+  reader->lost += reader->cursor - pos;
+
+  return 1;
+}
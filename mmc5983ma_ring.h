@@ -0,0 +1,68 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MMC5983MA_RING_H
+#define MMC5983MA_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "mmc5983ma.h"
+
+/**
+ * Single producer / many readers sample ring.
+ *
+ * The ring holds no pointer, so it can be placed in a POSIX shared memory
+ * object (shm_open + mmap of mmc5983ma_ring_size() bytes) and consumed by
+ * any number of processes. The producer never waits for readers: each reader
+ * owns its cursor, and a reader that falls more than one lap behind skips
+ * ahead and accounts the overwritten samples in its lost counter.
+ *
+ * Each sample carries the producer's sample index for its sensor, so a
+ * consumer can tell a missed or repeated acquisition from a gap in the ring
+ * and feed the index to mmc5983ma_ts_observe.
+ */
+
+typedef struct {
+  uint64_t index; // sample index of this sensor
+  uint32_t sensor;
+  uint32_t x;
+  uint32_t y;
+  uint32_t z;
+} mmc5983ma_ring_sample_t;
+
+typedef struct {
+  uint64_t seq; // 2 * pos + 1 while written, 2 * pos + 2 once published
+  mmc5983ma_ring_sample_t sample;
+} mmc5983ma_ring_slot_t;
+
+typedef struct {
+  uint32_t capacity; // power of two
+  uint32_t mask;
+  uint64_t head; // next position to be written
+  mmc5983ma_ring_slot_t slot[];
+} mmc5983ma_ring_t;
+
+typedef struct {
+  uint64_t cursor;
+  uint64_t lost;
+} mmc5983ma_ring_reader_t;
+
+size_t mmc5983ma_ring_size(uint32_t capacity);
+int32_t mmc5983ma_ring_init(mmc5983ma_ring_t *ring, uint32_t capacity);
+
+int32_t mmc5983ma_ring_push(mmc5983ma_ring_t *ring, uint32_t sensor,
+                            uint64_t index,
+                            const mmc5983ma_raw_magneto_data_t *raw);
+
+int32_t mmc5983ma_ring_reader_init(const mmc5983ma_ring_t *ring,
+                                   mmc5983ma_ring_reader_t *reader);
+int32_t mmc5983ma_ring_read(const mmc5983ma_ring_t *ring,
+                            mmc5983ma_ring_reader_t *reader,
+                            mmc5983ma_ring_sample_t *val);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
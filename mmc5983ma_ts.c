@@ -0,0 +1,164 @@
+#include "mmc5983ma_ts.h"
+#include <stdint.h>
+
+/**
+ * @brief  Sample period currently estimated, in ns
+ *
+ */
+static double mmc5983ma_ts_period(const mmc5983ma_ts_t *ts) {
+  if ((ts->count < 2) || (ts->cxx <= 0.0))
+    return ts->nominal_period;
+
+  return ts->cxy / ts->cxx;
+}
+
+/**
+ * @brief  Host time of a sample relative to t0, in ns
+ *
+ */
+static double mmc5983ma_ts_predict(const mmc5983ma_ts_t *ts, uint64_t index) {
+  double x = (double)(int64_t)(index - ts->n0);
+
+  return ts->my + mmc5983ma_ts_period(ts) * (x - ts->mx);
+}
+
+/**
+ * @brief  Initialise the timestamp engine
+ *
+ * @param  ts      engine state(ptr)
+ * @param  odr_hz  nominal output data rate (see mmc5983ma_cm_freq_set)
+ * @param  window  number of observations the estimate effectively spans,
+ *                 older ones fade out so temperature drift is tracked
+ * @retval          0 -> no Error, -1 -> invalid argument
+ *
+ */
+int32_t mmc5983ma_ts_init(mmc5983ma_ts_t *ts, float odr_hz, uint32_t window) {
+  if ((ts == NULL) || !(odr_hz > 0.f) || (window < 2))
+    return -1;
+
+  ts->nominal_period = 1e9 / (double)odr_hz;
+  ts->lambda = 1.0 - 1.0 / (double)window;
+  ts->window = window;
+  ts->count = 0;
+  ts->t0 = 0;
+  ts->n0 = 0;
+  ts->w = 0.0;
+  ts->mx = 0.0;
+  ts->my = 0.0;
+  ts->cxx = 0.0;
+  ts->cxy = 0.0;
+  ts->jitter2 = 0.0;
+
+  return 0;
+}
+
+/**
+ * @brief  Add a host clock observation
+ *
+ * @param  ts       engine state(ptr)
+ * @param  index    index of the sample read when the clock was sampled
+ * @param  host_ns  host clock (e.g. CLOCK_MONOTONIC) in ns
+ * @retval          0 -> no Error, -1 -> invalid argument
+ *
+ */
+int32_t mmc5983ma_ts_observe(mmc5983ma_ts_t *ts, uint64_t index,
+                             int64_t host_ns) {
+  double x;
+  double y;
+  double dx;
+  double dy;
+  double r;
+
+  if (ts == NULL)
+    return -1;
+
+  if (ts->count == 0) {
+    ts->t0 = host_ns;
+    ts->n0 = index;
+  }
+
+  x = (double)(int64_t)(index - ts->n0);
+  y = (double)(host_ns - ts->t0);
+
+  // Residual against the model before it learns from this observation
+  if (ts->count >= 2) {
+    r = y - mmc5983ma_ts_predict(ts, index);
+    ts->jitter2 += (r * r - ts->jitter2) /
+                   (double)(ts->count < ts->window ? ts->count : ts->window);
+  }
+
+  // Exponentially weighted Welford update
+  ts->w = ts->lambda * ts->w + 1.0;
+  dx = x - ts->mx;
+  dy = y - ts->my;
+  ts->mx += dx / ts->w;
+  ts->my += dy / ts->w;
+  ts->cxx = ts->lambda * ts->cxx + dx * (x - ts->mx);
+  ts->cxy = ts->lambda * ts->cxy + dx * (y - ts->my);
+
+  ts->count++;
+
+  return 0;
+}
+
+/**
+ * @brief  Stamp a batch of consecutive samples, no clock read involved
+ *
+ * @param  ts     engine state(ptr)
+ * @param  first  index of the first sample of the batch
+ * @param  count  number of samples in the batch
+ * @param  val    host time of each sample in ns, count entries(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument or no observation
+ *
+ */
+int32_t mmc5983ma_ts_stamp(const mmc5983ma_ts_t *ts, uint64_t first,
+                           uint32_t count, int64_t *val) {
+  double base;
+  double step;
+  uint32_t i;
+
+  if ((ts == NULL) || (val == NULL) || (ts->count == 0))
+    return -1;
+
+  base = mmc5983ma_ts_predict(ts, first);
+  step = mmc5983ma_ts_period(ts);
+
+  for (i = 0; i < count; i++)
+    val[i] = ts->t0 + llround(base + step * (double)i);
+
+  return 0;
+}
+
+/**
+ * @brief  Sensor oscillator error against the nominal ODR
+ *
+ * @param  ts   engine state(ptr)
+ * @param  val  drift in ppm, positive when the sensor runs fast(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument
+ *
+ */
+int32_t mmc5983ma_ts_drift_ppm_get(const mmc5983ma_ts_t *ts, float *val) {
+  if ((ts == NULL) || (val == NULL))
+    return -1;
+
+  *val = (float)((ts->nominal_period / mmc5983ma_ts_period(ts) - 1.0) * 1e6);
+
+  return 0;
+}
+
+/**
+ * @brief  Residual jitter of the observations against the model
+ *
+ * @param  ts   engine state(ptr)
+ * @param  val  RMS residual in ns(ptr)
+ * @retval          0 -> no Error, -1 -> invalid argument
+ *
+ */
+int32_t mmc5983ma_ts_jitter_get(const mmc5983ma_ts_t *ts, float *val) {
+  if ((ts == NULL) || (val == NULL))
+    return -1;
+
+  *val = (float)sqrt(ts->jitter2);
+
+  return 0;
+}
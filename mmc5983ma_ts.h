@@ -0,0 +1,53 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef MMC5983MA_TS_H
+#define MMC5983MA_TS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "mmc5983ma.h"
+
+/**
+ * Sample timestamp engine for continuous mode.
+ *
+ * The sensor paces samples with its own oscillator. Instead of reading the
+ * host clock for every sample, feed the engine a sparse set of observations
+ * (sample index, host time in ns), e.g. one every few hundred samples. It
+ * keeps an exponentially weighted linear regression of host time against
+ * sample index, from which it derives the true sample period (drift against
+ * the nominal ODR) and phase, then stamps whole batches by interpolation.
+ */
+
+typedef struct {
+  double nominal_period; // ns
+  double lambda;         // forgetting factor of the regression
+  uint32_t window;       // effective number of observations
+  uint32_t count;        // observations so far
+  int64_t t0;            // host time origin (ns)
+  uint64_t n0;           // sample index origin
+  double w;              // sum of weights
+  double mx;             // weighted mean of index - n0
+  double my;             // weighted mean of host time - t0 (ns)
+  double cxx;            // weighted co-moments
+  double cxy;
+  double jitter2; // mean square residual (ns^2)
+} mmc5983ma_ts_t;
+
+int32_t mmc5983ma_ts_init(mmc5983ma_ts_t *ts, float odr_hz, uint32_t window);
+
+int32_t mmc5983ma_ts_observe(mmc5983ma_ts_t *ts, uint64_t index,
+                             int64_t host_ns);
+
+int32_t mmc5983ma_ts_stamp(const mmc5983ma_ts_t *ts, uint64_t first,
+                           uint32_t count, int64_t *val);
+
+int32_t mmc5983ma_ts_drift_ppm_get(const mmc5983ma_ts_t *ts, float *val);
+int32_t mmc5983ma_ts_jitter_get(const mmc5983ma_ts_t *ts, float *val);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
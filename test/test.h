@@ -0,0 +1,46 @@
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef TEST_H
+#define TEST_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * Minimal check helpers shared by the test programs: every failed check is
+ * reported and counted, TEST_RESULT() turns the count into the exit code.
+ */
+
+static uint32_t test_failures;
+
+#define TEST_CHECK(cond)                                                       \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__,       \
+              #cond);                                                          \
+      test_failures++;                                                         \
+    }                                                                          \
+  } while (0)
+
+#define TEST_CHECK_NEAR(val, ref, tol)                                         \
+  do {                                                                         \
+    double test_v = (double)(val);                                             \
+    double test_r = (double)(ref);                                             \
+    if (!((test_v >= test_r - (tol)) && (test_v <= test_r + (tol)))) {         \
+      fprintf(stderr, "%s:%d: %s = %g, expected %g +/- %g\n", __FILE__,       \
+              __LINE__, #val, test_v, test_r, (double)(tol));                  \
+      test_failures++;                                                         \
+    }                                                                          \
+  } while (0)
+
+#define TEST_RESULT()                                                          \
+  (printf("%s: %s\n", __FILE__, test_failures ? "FAILED" : "ok"),             \
+   test_failures ? 1 : 0)
+
+/** Deterministic uniform random in [0, 1), the tests must be reproducible */
+static inline double test_uniform(uint32_t *seed) {
+  *seed = *seed * 1664525U + 1013904223U;
+  return (double)(*seed >> 8) / 16777216.0;
+}
+
+#endif
@@ -0,0 +1,116 @@
+#include "mmc5983ma_allan.h"
+#include "test.h"
+
+#define ALLAN_SAMPLES (1U << 18)
+#define ALLAN_PERIOD 0.01f
+#define ALLAN_GAUSS_PER_COUNT (0.0625 / 1e3)
+
+static double gaussian(uint32_t *seed) {
+  double u = test_uniform(seed);
+  double v = test_uniform(seed);
+
+  return sqrt(-2.0 * log(1.0 - u)) * cos(6.283185307179586 * v);
+}
+
+/**
+ * White noise of sigma counts on X (20) and Y (5), constant Z: the Allan
+ * deviation must fall as 1/sqrt(tau) from sigma at tau0.
+ */
+static void test_white_noise(void) {
+  mmc5983ma_allan_t allan;
+  mmc5983ma_raw_magneto_data_t raw = {0};
+  mmc5983ma_magneto_data_t val;
+  mmc5983ma_magneto_data_t adev0;
+  uint32_t seed = 99U;
+  double sx = 0.0;
+  double sy = 0.0;
+  double sxx = 0.0;
+  double sxy = 0.0;
+  double x;
+  double slope;
+  float tau;
+  uint32_t n = 0;
+  uint32_t i;
+  uint8_t level;
+
+  TEST_CHECK(mmc5983ma_allan_init(&allan, ALLAN_PERIOD) == 0);
+  for (i = 0; i < ALLAN_SAMPLES; i++) {
+    raw.xraw_1 = 131072U + (uint32_t)lround(20.0 * gaussian(&seed));
+    raw.yraw_1 = 100000U + (uint32_t)lround(5.0 * gaussian(&seed));
+    raw.zraw_1 = 150000U;
+    TEST_CHECK(mmc5983ma_allan_push(&allan, &raw) == 0);
+  }
+
+  TEST_CHECK(mmc5983ma_allan_deviation_get(&allan, 0, &tau, &adev0) == 0);
+  TEST_CHECK_NEAR(tau, ALLAN_PERIOD, 1e-9);
+  TEST_CHECK_NEAR(adev0.x, 20.0 * ALLAN_GAUSS_PER_COUNT,
+                  0.02 * 20.0 * ALLAN_GAUSS_PER_COUNT);
+  TEST_CHECK_NEAR(adev0.y, 5.0 * ALLAN_GAUSS_PER_COUNT,
+                  0.02 * 5.0 * ALLAN_GAUSS_PER_COUNT);
+  TEST_CHECK(adev0.z == 0.f);
+
+  // Each octave with at least 256 pairs follows sigma / sqrt(2^level)
+  for (level = 0; level < MMC5983MA_ALLAN_LEVELS; level++) {
+    if (allan.level[level].pairs < 256U)
+      break;
+    TEST_CHECK(mmc5983ma_allan_deviation_get(&allan, level, &tau, &val) == 0);
+    TEST_CHECK_NEAR(tau, ldexp(ALLAN_PERIOD, level), 1e-6 * tau);
+    TEST_CHECK_NEAR(val.x, adev0.x / sqrt(ldexp(1.0, level)),
+                    0.15 * adev0.x / sqrt(ldexp(1.0, level)));
+
+    x = log((double)tau);
+    sx += x;
+    sy += log((double)val.x);
+    sxx += x * x;
+    sxy += x * log((double)val.x);
+    n++;
+  }
+  TEST_CHECK(n >= 10U);
+
+  // Log-log slope of white noise is -1/2
+  slope = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+  TEST_CHECK_NEAR(slope, -0.5, 0.03);
+
+  // sigma(tau) = N / sqrt(tau) -> N = sigma * sqrt(tau0)
+  TEST_CHECK(mmc5983ma_allan_noise_density_get(&allan, &val) == 0);
+  TEST_CHECK_NEAR(val.x, 20.0 * ALLAN_GAUSS_PER_COUNT * sqrt(ALLAN_PERIOD),
+                  0.02 * 20.0 * ALLAN_GAUSS_PER_COUNT * sqrt(ALLAN_PERIOD));
+  TEST_CHECK_NEAR(val.y, 5.0 * ALLAN_GAUSS_PER_COUNT * sqrt(ALLAN_PERIOD),
+                  0.02 * 5.0 * ALLAN_GAUSS_PER_COUNT * sqrt(ALLAN_PERIOD));
+
+  // White noise has no flicker floor: the minimum is at the longest tau
+  TEST_CHECK(mmc5983ma_allan_bias_instability_get(&allan, &val) == 0);
+  TEST_CHECK(val.x > 0.f);
+  TEST_CHECK(val.x < adev0.x / 0.664f / 16.f);
+}
+
+static void test_args(void) {
+  mmc5983ma_allan_t allan;
+  mmc5983ma_raw_magneto_data_t raw = {0};
+  mmc5983ma_magneto_data_t val;
+  float tau;
+
+  TEST_CHECK(mmc5983ma_allan_init(NULL, 0.01f) == -1);
+  TEST_CHECK(mmc5983ma_allan_init(&allan, 0.f) == -1);
+  TEST_CHECK(mmc5983ma_allan_init(&allan, 0.01f) == 0);
+
+  // Nothing to report before a pair of clusters exists
+  TEST_CHECK(mmc5983ma_allan_deviation_get(&allan, 0, &tau, &val) == -1);
+  TEST_CHECK(mmc5983ma_allan_noise_density_get(&allan, &val) == -1);
+  TEST_CHECK(mmc5983ma_allan_bias_instability_get(&allan, &val) == -1);
+
+  TEST_CHECK(mmc5983ma_allan_push(&allan, &raw) == 0);
+  TEST_CHECK(mmc5983ma_allan_push(&allan, &raw) == 0);
+  TEST_CHECK(mmc5983ma_allan_deviation_get(&allan, 0, &tau, &val) == 0);
+  TEST_CHECK(mmc5983ma_allan_deviation_get(&allan, 1, &tau, &val) == -1);
+  TEST_CHECK(mmc5983ma_allan_deviation_get(&allan, MMC5983MA_ALLAN_LEVELS,
+                                           &tau, &val) == -1);
+  TEST_CHECK(mmc5983ma_allan_push(&allan, NULL) == -1);
+}
+
+int main(void) {
+  test_args();
+  test_white_noise();
+
+  return TEST_RESULT();
+}
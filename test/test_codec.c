@@ -0,0 +1,153 @@
+#include "mmc5983ma_codec.h"
+#include "test.h"
+#include <string.h>
+
+#define CODEC_MAX 1024U
+
+static mmc5983ma_raw_magneto_data_t in[CODEC_MAX];
+static mmc5983ma_raw_magneto_data_t out[CODEC_MAX];
+static uint8_t buf[MMC5983MA_CODEC_BLOCK_BOUND(CODEC_MAX)];
+
+static void set(uint32_t i, uint32_t x, uint32_t y, uint32_t z) {
+  in[i].xraw_1 = x;
+  in[i].yraw_1 = y;
+  in[i].zraw_1 = z;
+}
+
+/**
+ * @brief  Encode, check the bound, decode and compare; returns the length
+ *
+ */
+static size_t round_trip(uint16_t count) {
+  size_t len = 0;
+  uint16_t n = 0;
+  uint32_t i;
+
+  memset(out, 0xa5, sizeof(out));
+  TEST_CHECK(mmc5983ma_codec_encode(in, count, buf, sizeof(buf), &len) == 0);
+  TEST_CHECK(len <= MMC5983MA_CODEC_BLOCK_BOUND(count));
+  TEST_CHECK(mmc5983ma_codec_decode(buf, len, out, CODEC_MAX, &n) == 0);
+  TEST_CHECK(n == count);
+
+  for (i = 0; i < count; i++) {
+    TEST_CHECK(out[i].xraw_1 == (in[i].xraw_1 & 0x3FFFFU));
+    TEST_CHECK(out[i].yraw_1 == (in[i].yraw_1 & 0x3FFFFU));
+    TEST_CHECK(out[i].zraw_1 == (in[i].zraw_1 & 0x3FFFFU));
+  }
+
+  return len;
+}
+
+static void test_random(void) {
+  uint32_t seed = 7U;
+  uint32_t i;
+
+  // Full scale noise: every delta is large, most codes take the escape
+  for (i = 0; i < CODEC_MAX; i++)
+    set(i, (uint32_t)(test_uniform(&seed) * 262144.0),
+        (uint32_t)(test_uniform(&seed) * 262144.0),
+        (uint32_t)(test_uniform(&seed) * 262144.0));
+  round_trip(CODEC_MAX);
+  round_trip(17);
+}
+
+static void test_random_walk(void) {
+  uint32_t seed = 11U;
+  uint32_t x = 131072U;
+  uint32_t y = 100000U;
+  uint32_t z = 150000U;
+  uint32_t i;
+  size_t len;
+
+  for (i = 0; i < CODEC_MAX; i++) {
+    x += (uint32_t)(test_uniform(&seed) * 41.0) - 20U;
+    y += (uint32_t)(test_uniform(&seed) * 9.0) - 4U;
+    z += (uint32_t)(test_uniform(&seed) * 201.0) - 100U;
+    set(i, x, y, z);
+  }
+
+  // Sensor like data must actually compress
+  len = round_trip(CODEC_MAX);
+  TEST_CHECK(len * 4U < CODEC_MAX * 12U);
+}
+
+static void test_wrap(void) {
+  uint32_t i;
+
+  // Largest deltas both ways between the ends of the 18-bit range
+  for (i = 0; i < 64U; i++)
+    set(i, (i & 1U) ? 0x3FFFFU : 0U, (i & 1U) ? 0U : 0x3FFFFU,
+        (i & 2U) ? 0x3FFFFU : 1U);
+  round_trip(64);
+
+  // Values above 18 bits are not representable, only the 18 bits are kept
+  for (i = 0; i < 8U; i++)
+    set(i, 0xFFFC0000U | i, 0x40000U + i, 0x3FFFFU - i);
+  round_trip(8);
+}
+
+static void test_escape(void) {
+  uint32_t i;
+
+  // Quiet block with single jumps far beyond the Rice parameter chosen for
+  // the block, those codes take the escape
+  for (i = 0; i < 256U; i++)
+    set(i, 131072U, 131072U, 131072U);
+  in[100].xraw_1 = 131072U + 200000U;
+  in[101].yraw_1 = 131072U - 131072U;
+  in[255].zraw_1 = 0x3FFFFU;
+  TEST_CHECK(round_trip(256) < 256U * 12U);
+}
+
+static void test_single(void) {
+  set(0, 0x3FFFFU, 0U, 131072U);
+  TEST_CHECK(round_trip(1) == MMC5983MA_CODEC_BLOCK_BOUND(1));
+}
+
+static void test_truncated(void) {
+  uint32_t seed = 3U;
+  size_t len;
+  size_t cut;
+  uint16_t n;
+  uint32_t i;
+
+  for (i = 0; i < 200U; i++)
+    set(i, 131072U + (uint32_t)(test_uniform(&seed) * 64.0),
+        131072U + (uint32_t)(test_uniform(&seed) * 2000.0),
+        (i % 50U == 0U) ? (uint32_t)(test_uniform(&seed) * 262144.0)
+                        : 131072U);
+  len = round_trip(200);
+
+  // The last byte always carries code bits, any shorter block is corrupt
+  for (cut = 0; cut < len; cut++)
+    TEST_CHECK(mmc5983ma_codec_decode(buf, cut, out, CODEC_MAX, &n) == -1);
+
+  // Output too small for the block, output buffer too small for the codes
+  TEST_CHECK(mmc5983ma_codec_decode(buf, len, out, 199, &n) == -1);
+  TEST_CHECK(mmc5983ma_codec_encode(in, 200, buf, len - 1U, &len) == -1);
+}
+
+static void test_args(void) {
+  size_t len;
+  uint16_t n;
+
+  TEST_CHECK(mmc5983ma_codec_encode(in, 0, buf, sizeof(buf), &len) == -1);
+  TEST_CHECK(mmc5983ma_codec_encode(NULL, 1, buf, sizeof(buf), &len) == -1);
+  TEST_CHECK(mmc5983ma_codec_decode(NULL, 4, out, CODEC_MAX, &n) == -1);
+
+  // A zero sample count is never produced by the encoder
+  memset(buf, 0, 16);
+  TEST_CHECK(mmc5983ma_codec_decode(buf, 16, out, CODEC_MAX, &n) == -1);
+}
+
+int main(void) {
+  test_args();
+  test_single();
+  test_random();
+  test_random_walk();
+  test_wrap();
+  test_escape();
+  test_truncated();
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,164 @@
+#include "mmc5983ma_ring.h"
+#include "test.h"
+#include <stdlib.h>
+
+static mmc5983ma_ring_t *ring_new(uint32_t capacity) {
+  mmc5983ma_ring_t *ring = malloc(mmc5983ma_ring_size(capacity));
+
+  TEST_CHECK(ring != NULL);
+  TEST_CHECK(mmc5983ma_ring_init(ring, capacity) == 0);
+
+  return ring;
+}
+
+// Sample n of the producer: sensor n % 3, axes derived from n
+static void ring_push_n(mmc5983ma_ring_t *ring, uint64_t first,
+                        uint64_t count) {
+  mmc5983ma_raw_magneto_data_t raw;
+  uint64_t n;
+
+  for (n = first; n < first + count; n++) {
+    raw.xraw_1 = (uint32_t)n & 0x3FFFFU;
+    raw.yraw_1 = (uint32_t)(n * 3U) & 0x3FFFFU;
+    raw.zraw_1 = 0x3FFFFU - ((uint32_t)n & 0x3FFFFU);
+    TEST_CHECK(mmc5983ma_ring_push(ring, (uint32_t)(n % 3U), n, &raw) == 0);
+  }
+}
+
+static void ring_check_sample(const mmc5983ma_ring_sample_t *s, uint64_t n) {
+  TEST_CHECK(s->index == n);
+  TEST_CHECK(s->sensor == (uint32_t)(n % 3U));
+  TEST_CHECK(s->x == ((uint32_t)n & 0x3FFFFU));
+  TEST_CHECK(s->y == ((uint32_t)(n * 3U) & 0x3FFFFU));
+  TEST_CHECK(s->z == 0x3FFFFU - ((uint32_t)n & 0x3FFFFU));
+}
+
+static void test_args(void) {
+  mmc5983ma_ring_t *ring = ring_new(4);
+  mmc5983ma_ring_reader_t reader;
+  mmc5983ma_ring_sample_t sample;
+  mmc5983ma_raw_magneto_data_t raw = {0};
+
+  // Capacity 1 would resync a lapped reader past the newest sample
+  TEST_CHECK(mmc5983ma_ring_size(0) == 0);
+  TEST_CHECK(mmc5983ma_ring_size(1) == 0);
+  TEST_CHECK(mmc5983ma_ring_size(6) == 0);
+  TEST_CHECK(mmc5983ma_ring_size(2) != 0);
+  TEST_CHECK(mmc5983ma_ring_init(ring, 1) == -1);
+  TEST_CHECK(mmc5983ma_ring_init(NULL, 4) == -1);
+
+  TEST_CHECK(mmc5983ma_ring_push(NULL, 0, 0, &raw) == -1);
+  TEST_CHECK(mmc5983ma_ring_push(ring, 0, 0, NULL) == -1);
+  TEST_CHECK(mmc5983ma_ring_reader_init(ring, NULL) == -1);
+  TEST_CHECK(mmc5983ma_ring_reader_init(ring, &reader) == 0);
+  TEST_CHECK(mmc5983ma_ring_read(ring, &reader, NULL) == -1);
+  TEST_CHECK(mmc5983ma_ring_read(NULL, &reader, &sample) == -1);
+
+  free(ring);
+}
+
+static void test_in_order(void) {
+  mmc5983ma_ring_t *ring = ring_new(8);
+  mmc5983ma_ring_reader_t reader;
+  mmc5983ma_ring_sample_t sample;
+  uint64_t n;
+
+  // Empty: nothing read, nothing lost
+  TEST_CHECK(mmc5983ma_ring_reader_init(ring, &reader) == 0);
+  TEST_CHECK(mmc5983ma_ring_read(ring, &reader, &sample) == 1);
+  TEST_CHECK((reader.cursor == 0) && (reader.lost == 0));
+
+  // A full ring behind the producer is still readable
+  ring_push_n(ring, 0, 8);
+  for (n = 0; n < 8U; n++) {
+    TEST_CHECK(mmc5983ma_ring_read(ring, &reader, &sample) == 0);
+    ring_check_sample(&sample, n);
+  }
+  TEST_CHECK(mmc5983ma_ring_read(ring, &reader, &sample) == 1);
+  TEST_CHECK((reader.cursor == 8) && (reader.lost == 0));
+
+  free(ring);
+}
+
+static void test_lapped(void) {
+  mmc5983ma_ring_t *ring = ring_new(8);
+  mmc5983ma_ring_reader_t reader;
+  mmc5983ma_ring_sample_t sample;
+  uint64_t n;
+
+  // One sample more than the capacity: resync half a ring behind head
+  TEST_CHECK(mmc5983ma_ring_reader_init(ring, &reader) == 0);
+  ring_push_n(ring, 0, 9);
+  TEST_CHECK(mmc5983ma_ring_read(ring, &reader, &sample) == 1);
+  TEST_CHECK((reader.cursor == 5) && (reader.lost == 5));
+  for (n = 5; n < 9U; n++) {
+    TEST_CHECK(mmc5983ma_ring_read(ring, &reader, &sample) == 0);
+    ring_check_sample(&sample, n);
+  }
+  TEST_CHECK(mmc5983ma_ring_read(ring, &reader, &sample) == 1);
+
+  // Several laps: lost counts every skipped sample
+  ring_push_n(ring, 9, 100);
+  TEST_CHECK(mmc5983ma_ring_read(ring, &reader, &sample) == 1);
+  TEST_CHECK((reader.cursor == 105) && (reader.lost == 5 + 96));
+  TEST_CHECK(mmc5983ma_ring_read(ring, &reader, &sample) == 0);
+  ring_check_sample(&sample, 105);
+
+  free(ring);
+}
+
+static void test_torn(void) {
+  mmc5983ma_ring_t *ring = ring_new(4);
+  mmc5983ma_ring_reader_t reader;
+  mmc5983ma_ring_sample_t sample;
+
+  // Producer caught writing position 4 over slot 0: the copy is discarded
+  TEST_CHECK(mmc5983ma_ring_reader_init(ring, &reader) == 0);
+  ring_push_n(ring, 0, 4);
+  ring->slot[0].seq = 2U * 4U + 1U;
+  TEST_CHECK(mmc5983ma_ring_read(ring, &reader, &sample) == 1);
+  TEST_CHECK((reader.cursor == 2) && (reader.lost == 2));
+  TEST_CHECK(mmc5983ma_ring_read(ring, &reader, &sample) == 0);
+  ring_check_sample(&sample, 2);
+
+  free(ring);
+}
+
+static void test_late_reader(void) {
+  mmc5983ma_ring_t *ring = ring_new(2);
+  mmc5983ma_ring_reader_t early;
+  mmc5983ma_ring_reader_t late;
+  mmc5983ma_ring_sample_t sample;
+
+  TEST_CHECK(mmc5983ma_ring_reader_init(ring, &early) == 0);
+  ring_push_n(ring, 0, 5);
+
+  // Attached mid-stream: only what is pushed afterwards
+  TEST_CHECK(mmc5983ma_ring_reader_init(ring, &late) == 0);
+  TEST_CHECK(mmc5983ma_ring_read(ring, &late, &sample) == 1);
+  TEST_CHECK((late.cursor == 5) && (late.lost == 0));
+
+  // Smallest ring: the lapped reader keeps the newest sample
+  TEST_CHECK(mmc5983ma_ring_read(ring, &early, &sample) == 1);
+  TEST_CHECK((early.cursor == 4) && (early.lost == 4));
+  TEST_CHECK(mmc5983ma_ring_read(ring, &early, &sample) == 0);
+  ring_check_sample(&sample, 4);
+
+  ring_push_n(ring, 5, 1);
+  TEST_CHECK(mmc5983ma_ring_read(ring, &late, &sample) == 0);
+  ring_check_sample(&sample, 5);
+  TEST_CHECK(mmc5983ma_ring_read(ring, &early, &sample) == 0);
+  ring_check_sample(&sample, 5);
+
+  free(ring);
+}
+
+int main(void) {
+  test_args();
+  test_in_order();
+  test_lapped();
+  test_torn();
+  test_late_reader();
+
+  return TEST_RESULT();
+}
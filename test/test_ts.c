@@ -0,0 +1,74 @@
+#include "mmc5983ma_ts.h"
+#include "test.h"
+
+#define TS_ODR_HZ 100.0
+#define TS_JITTER_NS 10000.0 // host observation jitter, uniform +/-
+#define TS_OBS_EVERY 97U     // samples between two host clock reads
+
+/**
+ * Simulated sensor: sample n is taken at t0 + n * period, the period being
+ * skewed by skew_ppm from the nominal ODR. The host reads its clock every
+ * TS_OBS_EVERY samples, with uniform jitter.
+ */
+static void test_skew(double skew_ppm) {
+  mmc5983ma_ts_t ts;
+  double period = 1e9 / (TS_ODR_HZ * (1.0 + skew_ppm * 1e-6));
+  const double t0 = 5e12;
+  uint32_t seed = 12345U;
+  int64_t stamps[64];
+  float drift;
+  float jitter;
+  uint64_t n;
+  uint32_t i;
+
+  TEST_CHECK(mmc5983ma_ts_init(&ts, (float)TS_ODR_HZ, 64) == 0);
+
+  for (n = 1000; n < 200000; n += TS_OBS_EVERY) {
+    double noise = (test_uniform(&seed) * 2.0 - 1.0) * TS_JITTER_NS;
+    TEST_CHECK(mmc5983ma_ts_observe(&ts, n,
+                                    (int64_t)(t0 + period * (double)n + noise)) ==
+               0);
+  }
+
+  TEST_CHECK(mmc5983ma_ts_drift_ppm_get(&ts, &drift) == 0);
+  TEST_CHECK_NEAR(drift, skew_ppm, 1.0);
+
+  // RMS of uniform +/-J noise is J / sqrt(3)
+  TEST_CHECK(mmc5983ma_ts_jitter_get(&ts, &jitter) == 0);
+  TEST_CHECK_NEAR(jitter, TS_JITTER_NS / 1.7320508, 0.1 * TS_JITTER_NS);
+
+  // Interpolated stamps of the next batch, well below the host jitter
+  TEST_CHECK(mmc5983ma_ts_stamp(&ts, n, 64, stamps) == 0);
+  for (i = 0; i < 64U; i++)
+    TEST_CHECK_NEAR(stamps[i], t0 + period * (double)(n + i), 3000.0);
+}
+
+static void test_args(void) {
+  mmc5983ma_ts_t ts;
+  int64_t stamp;
+  float val;
+
+  TEST_CHECK(mmc5983ma_ts_init(NULL, 100.f, 64) == -1);
+  TEST_CHECK(mmc5983ma_ts_init(&ts, 0.f, 64) == -1);
+  TEST_CHECK(mmc5983ma_ts_init(&ts, 100.f, 1) == -1);
+  TEST_CHECK(mmc5983ma_ts_init(&ts, 100.f, 64) == 0);
+
+  // No observation yet: nothing to stamp from, nominal rate assumed
+  TEST_CHECK(mmc5983ma_ts_stamp(&ts, 0, 1, &stamp) == -1);
+  TEST_CHECK(mmc5983ma_ts_drift_ppm_get(&ts, &val) == 0);
+  TEST_CHECK(val == 0.f);
+
+  // A single observation fixes the phase, the period stays nominal
+  TEST_CHECK(mmc5983ma_ts_observe(&ts, 10, 1000000000) == 0);
+  TEST_CHECK(mmc5983ma_ts_stamp(&ts, 12, 1, &stamp) == 0);
+  TEST_CHECK(stamp == 1020000000);
+}
+
+int main(void) {
+  test_args();
+  test_skew(50.0);
+  test_skew(-120.0);
+  test_skew(0.0);
+
+  return TEST_RESULT();
+}